@@ -0,0 +1,1315 @@
+/*
+File:   debug_alignment_bench.cpp
+Author: Will Jenkins
+Purpose: Headless benchmark harness for the debug alignment overlay
+
+Runs repeatable scenarios against DebugAlignmentEnhanced with an in-memory
+framebuffer display and a scripted pointer, then reports time per operation,
+frames rendered and LVGL heap growth. Intended for Linux CI boxes before flashing devices.
+
+Usage:
+    debug_alignment_bench [--scenario NAME] [--widgets N] [--moves N]
+                          [--switches N] [--frames N] [--csv] [--verbose] [--list]
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Friend of DebugAlignmentEnhanced: lets scenarios drive the private spawn/select
+// paths directly instead of scripting taps for every single operation.
+class DebugAlignmentBench {
+public:
+    using DA = DebugAlignmentEnhanced;
+    using WidgetType = DA::WidgetType;
+
+    static void spawn(WidgetType type) { DA::spawn_widget(type); }
+    // Select by object list position
+    static void select(int index) { DA::set_active_object(DA::get_object_at(index)); }
+    static void delete_active() { DA::delete_active_object(); }
+    // Move the object at a list position through the normal transform path
+    static void place(int index, int32_t x, int32_t y) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        if (!obj) return;
+        obj->transform.x_offset = x;
+        obj->transform.y_offset = y;
+        DA::mark_transform_dirty(*obj, DA::TRANSFORM_X | DA::TRANSFORM_Y);
+    }
+    // Handlers as a control button runs them: snapshot, handler, journal
+    static void journaled(lv_event_cb_t handler) { DA::run_journaled(handler, nullptr); }
+    static lv_event_cb_t move_right_handler() { return DA::move_right_event; }
+    static lv_event_cb_t move_down_handler() { return DA::move_down_event; }
+    static lv_event_cb_t resize_wider_handler() { return DA::resize_wider_event; }
+    static lv_event_cb_t canvas_format_handler() { return DA::canvas_format_cycle_event; }
+    static lv_event_cb_t back_handler() { return DA::back_to_menu_event; }
+    static lv_event_cb_t button_state_handler() { return DA::button_toggle_state_event; }
+    static lv_event_cb_t button_disabled_handler() { return DA::button_toggle_disabled_event; }
+    static const ToggleProps* toggle_props(int index) {
+        const DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        return obj ? obj->props_as<ToggleProps>() : nullptr;
+    }
+    // Show a test pattern on the canvas at a list position, repainted straight into its buffer
+    static void paint_canvas(int index, TestPattern pattern) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+        if (!canvas) return;
+        canvas->test_drawing = true;
+        canvas->test_pattern = (uint8_t)pattern;
+        DA::paint_canvas(*obj);
+    }
+    static bool undo() { return DA::undo(); }
+    static bool redo() { return DA::redo(); }
+    static size_t journal_bytes() { return DA::journal.bytes_used(); }
+    static void set_guide_snap(bool enabled) { DA::guide_snap_enabled = enabled; }
+    // What picking cost before the index: every object, coordinates read back from LVGL
+    static DA::ObjectHandle pick_linear(int32_t x, int32_t y) {
+        DA::ObjectHandle top;
+        int32_t top_index = -1;
+        for (int i = 0; i < DA::spawned_objects.size(); i++) {
+            const DA::SpawnedObject& obj = DA::spawned_objects.at(i);
+            lv_area_t coords;
+            lv_obj_get_coords(obj.object, &coords);
+            if (x < coords.x1 || x > coords.x2 || y < coords.y1 || y > coords.y2) continue;
+            int32_t index = lv_obj_get_index(obj.object);
+            if (index > top_index) {
+                top_index = index;
+                top = DA::spawned_objects.handle_at(i);
+            }
+        }
+        return top;
+    }
+    static void refresh_object_list() { DA::update_object_list(); }
+    static void move_left() { DA::move_left_event(nullptr); }
+    static void move_right() { DA::move_right_event(nullptr); }
+    static void move_up() { DA::move_up_event(nullptr); }
+    static void move_down() { DA::move_down_event(nullptr); }
+    // Forget the retained per-type control panels so the next selection builds from scratch
+    static void drop_control_panels() {
+        for (auto& panel : DA::control_panels) {
+            if (panel.root) lv_obj_delete(panel.root);
+            panel = DA::ControlPanel();
+        }
+        DA::widget_controls_parent = nullptr;
+        DA::grid_label_ptr = nullptr;
+        DA::grid_toggle_label_ptr = nullptr;
+    }
+    // Chart at a list position: point count, feed rate, update mode (0 circular, 1 shift)
+    // and min/max decimation
+    static void set_chart(int index, int points, int feed_rate, int update_mode, int decimate = 0) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+        if (!chart) return;
+        chart->chart_points = points;
+        chart->feed_rate = feed_rate;
+        chart->update_mode = update_mode;
+        chart->decimate = decimate;
+        DA::apply_chart_props(*obj);
+    }
+    // Points lv_chart actually holds per series
+    static uint32_t chart_point_count(int index) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        return obj && obj->object ? lv_chart_get_point_count(obj->object) : 0;
+    }
+    static const DA::ChartFeed* chart_feed(int index) { return DA::find_chart_feed(DA::get_object_at(index)); }
+    // What the panel's frame timing strip has seen, drained first: totals over the
+    // frames still in its history (the last PERF_HISTORY)
+    struct PerfSummary {
+        uint32_t frames = 0;
+        uint64_t render_us = 0;
+        uint64_t flush_us = 0;
+        uint64_t pixels = 0;
+    };
+    static PerfSummary perf_summary() {
+        DA::perf_timer_cb(DA::perf_timer);
+        PerfSummary summary;
+        summary.frames = std::min<uint32_t>(DA::frame_history_count, DA::PERF_HISTORY);
+        for (uint32_t i = 0; i < summary.frames; i++) {
+            const DA::FrameSample& frame = DA::frame_history[i];
+            summary.render_us += frame.render_us;
+            summary.flush_us += frame.flush_us;
+            summary.pixels += frame.pixels;
+        }
+        return summary;
+    }
+    static void perf_reset() {
+        DA::perf_timer_cb(DA::perf_timer);
+        DA::frame_history_count = 0;
+    }
+    // One journal field of the object at a list position, as undo/redo writes it
+    static void write(int index, uint8_t field, int32_t value) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        if (obj) DA::write_field(*obj, field, value);
+    }
+    // Style edits the render cost ranking is meant to catch
+    static void set_rotation(int index, int32_t degrees) { write(index, DA::FIELD_ROTATION, degrees); }
+    static void set_opacity(int index, lv_opa_t opa) { write(index, DA::FIELD_OPA, opa); }
+    static void set_rounded_caps(int index) {
+        DA::SpawnedObject* obj = DA::get_object(DA::get_object_at(index));
+        ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+        if (!arc) return;
+        arc->rounded_caps = true;
+        DA::apply_properties_to_object(*obj);
+    }
+    static const char* object_name(DA::ObjectHandle handle) {
+        const DA::SpawnedObject* obj = DA::get_object(handle);
+        return obj ? obj->name.c_str() : "?";
+    }
+    // Redraw heatmap accumulated so far
+    static const RedrawHeatmap& redraw_heatmap() { return DA::redraw_heatmap; }
+    // Event trace records held in the ring and recorded since the last clear
+    static size_t trace_buffered() { return DA::event_trace.buffered(); }
+    static uint64_t trace_recorded() { return DA::event_trace.recorded(); }
+    static size_t object_record_size() { return sizeof(DA::SpawnedObject); }
+    static lv_obj_t* toggle_button() { return DA::toggle_button; }
+    static bool panel_built() { return DA::debug_panel != nullptr; }
+    static int control_tab_count() { return (int)DA::ControlTab::COUNT; }
+    // Tab bar button for one of a built panel's tabs, for tapping through the scripted pointer
+    static lv_obj_t* tab_button(WidgetType type, int tab) {
+        const DA::ControlPanel& panel = DA::control_panels[(int)type];
+        if (!panel.tab_view) return nullptr;
+        return lv_obj_get_child(lv_tabview_get_tab_btns(panel.tab_view), tab);
+    }
+    static lv_obj_t* object_strip() { return DA::object_strip; }
+    // Pooled chip currently bound to index, or nullptr if it is not in view
+    static lv_obj_t* chip_for(int index) {
+        for (const auto& slot : DA::object_chips) {
+            if (slot.bound_index == index) return slot.chip;
+        }
+        return nullptr;
+    }
+    static int live_chip_count() { return DA::OBJECT_CHIP_POOL; }
+    static int chip_pitch() { return DA::OBJECT_CHIP_PITCH; }
+    static bool panel_visible() { return DA::panel_visible; }
+};
+
+namespace {
+
+using Bench = DebugAlignmentBench;
+using Clock = std::chrono::steady_clock;
+
+constexpr int32_t kScreenWidth = 1280;
+constexpr int32_t kScreenHeight = 800;
+constexpr int32_t kBufferLines = kScreenHeight / 10;
+constexpr uint32_t kFrameMs = LV_DEF_REFR_PERIOD;
+constexpr int kWidgetTypeCount = 14;
+
+struct BenchConfig {
+    int widgets = 200;
+    int moves = 50;
+    int switches = 100;
+    int frames = 120;
+    bool csv = false;
+    bool verbose = false;  // Keep overlay log output instead of discarding it
+};
+
+struct BenchResult {
+    std::string name;
+    uint32_t ops = 0;
+    double op_us = 0;       // Total time spent inside the operations
+    double render_us = 0;   // Total time spent in timer/refresh pumping after them
+    uint32_t frames = 0;
+    uint64_t pixels = 0;
+    int64_t heap_bytes = 0; // Net LVGL heap growth across the scenario step
+};
+
+// ---------------------------------------------------------------------------
+// In-memory display driver
+// ---------------------------------------------------------------------------
+
+struct DisplayStats {
+    uint32_t frames = 0;
+    uint64_t pixels = 0;
+};
+
+lv_display_t* display = nullptr;
+DisplayStats display_stats;
+alignas(4) uint8_t draw_buf[kScreenWidth * kBufferLines * 2];  // RGB565
+std::vector<uint16_t> framebuffer(kScreenWidth * kScreenHeight);
+
+void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(px_map);
+    int32_t w = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        std::memcpy(&framebuffer[y * kScreenWidth + area->x1], src, w * sizeof(uint16_t));
+        src += w;
+    }
+    display_stats.pixels += lv_area_get_size(area);
+    if (lv_display_flush_is_last(disp)) display_stats.frames++;
+    lv_display_flush_ready(disp);
+}
+
+// ---------------------------------------------------------------------------
+// Scripted pointer input device
+// ---------------------------------------------------------------------------
+
+struct PointerStep {
+    lv_point_t point;
+    lv_indev_state_t state;
+};
+
+lv_indev_t* pointer = nullptr;
+std::deque<PointerStep> pointer_script;
+lv_point_t pointer_last = {0, 0};
+
+void pointer_read_cb(lv_indev_t*, lv_indev_data_t* data) {
+    if (pointer_script.empty()) {
+        data->point = pointer_last;
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    PointerStep step = pointer_script.front();
+    pointer_script.pop_front();
+    pointer_last = step.point;
+    data->point = step.point;
+    data->state = step.state;
+}
+
+// Advance LVGL time by one frame and run timers (input read, refresh)
+void pump() {
+    lv_tick_inc(kFrameMs);
+    lv_timer_handler();
+}
+
+// Queue a press/release on the center of obj and pump until it is consumed
+void tap(lv_obj_t* obj) {
+    if (!obj) return;
+    lv_obj_update_layout(obj);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_point_t p = {(coords.x1 + coords.x2) / 2, (coords.y1 + coords.y2) / 2};
+    pointer_script.push_back({p, LV_INDEV_STATE_PRESSED});
+    pointer_script.push_back({p, LV_INDEV_STATE_PRESSED});
+    pointer_script.push_back({p, LV_INDEV_STATE_RELEASED});
+    while (!pointer_script.empty()) pump();
+    pump();
+}
+
+// ---------------------------------------------------------------------------
+// Measurement helpers
+// ---------------------------------------------------------------------------
+
+// Bytes currently allocated from the LVGL heap (builtin allocator)
+int64_t heap_used() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return (int64_t)mon.total_size - (int64_t)mon.free_size;
+}
+
+double elapsed_us(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Times one operation followed by one frame; accumulates into result
+template <typename Fn>
+void measure(BenchResult& result, Fn&& op) {
+    Clock::time_point t0 = Clock::now();
+    op();
+    result.op_us += elapsed_us(t0);
+
+    Clock::time_point t1 = Clock::now();
+    pump();
+    result.render_us += elapsed_us(t1);
+    result.ops++;
+}
+
+// Fresh screen with the overlay opened through the scripted pointer
+lv_obj_t* begin_scene() {
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_screen_load(screen);
+    DebugAlignmentEnhanced::init(screen);
+    pump();
+    tap(Bench::toggle_button());
+    if (!Bench::panel_visible()) {
+        fprintf(stderr, "[BENCH] warning: scripted tap did not open the panel\n");
+        DebugAlignmentEnhanced::toggle();
+    }
+    pump();
+    return screen;
+}
+
+void end_scene(lv_obj_t* screen) {
+    DebugAlignmentEnhanced::cleanup();
+    lv_obj_delete(screen);
+    pump();
+}
+
+void spawn_many(int count) {
+    for (int i = 0; i < count; i++) {
+        Bench::spawn(static_cast<Bench::WidgetType>(i % kWidgetTypeCount));
+    }
+}
+
+// Runs body between display counter snapshots so frames/pixels are attributed
+template <typename Fn>
+BenchResult run_counted(const char* name, Fn&& body) {
+    BenchResult result;
+    result.name = name;
+    DisplayStats before = display_stats;
+    int64_t heap_before = heap_used();
+    body(result);
+    result.frames = display_stats.frames - before.frames;
+    result.pixels = display_stats.pixels - before.pixels;
+    result.heap_bytes = heap_used() - heap_before;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+void scenario_spawn(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    out.push_back(run_counted("spawn_widget", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.widgets; i++) {
+            measure(r, [&] { Bench::spawn(static_cast<Bench::WidgetType>(i % kWidgetTypeCount)); });
+        }
+    }));
+    end_scene(screen);
+}
+
+void scenario_move(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    out.push_back(run_counted("move_event", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.widgets; i++) {
+            Bench::select(i);
+            pump();
+            for (int m = 0; m < cfg.moves; m++) {
+                switch (m % 4) {
+                    case 0: measure(r, Bench::move_right); break;
+                    case 1: measure(r, Bench::move_down); break;
+                    case 2: measure(r, Bench::move_left); break;
+                    default: measure(r, Bench::move_up); break;
+                }
+            }
+        }
+    }));
+    end_scene(screen);
+}
+
+// Button mashing / long-press repeat: --moves events land between two frames, and
+// the frame after them pays for a single coalesced transform push
+void scenario_move_burst(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(kWidgetTypeCount);
+    pump();
+    out.push_back(run_counted("move_burst", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            Bench::select(i % kWidgetTypeCount);
+            pump();
+            measure(r, [&] {
+                for (int m = 0; m < cfg.moves; m++) {
+                    if (m % 2) Bench::move_down(); else Bench::move_right();
+                }
+            });
+        }
+    }));
+    end_scene(screen);
+}
+
+void scenario_switch(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    out.push_back(run_counted("set_active_object", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            // Stride through the list so consecutive switches hit different widget types
+            int index = (i * 7) % cfg.widgets;
+            measure(r, [&] { Bench::select(index); });
+        }
+    }));
+    end_scene(screen);
+}
+
+void scenario_object_list(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    out.push_back(run_counted("update_object_list", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            measure(r, Bench::refresh_object_list);
+        }
+    }));
+    // Scroll the strip end to end one chip at a time; the chip pool stays constant
+    out.push_back(run_counted("scroll_object_list", [&](BenchResult& r) {
+        lv_obj_t* strip = Bench::object_strip();
+        for (int i = 0; i < cfg.widgets; i++) {
+            measure(r, [&] { lv_obj_scroll_to_x(strip, i * Bench::chip_pitch(), LV_ANIM_OFF); });
+        }
+    }));
+    printf("[BENCH] object list: %d objects, %d live chips\n", cfg.widgets, Bench::live_chip_count());
+    end_scene(screen);
+}
+
+// Delete from the front of the list until it is empty: the old vector erase shifted
+// (and renamed) every later object, the slot map moves only the last one
+void scenario_delete(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    out.push_back(run_counted("delete_active_object", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.widgets; i++) {
+            Bench::select(0);
+            measure(r, Bench::delete_active);
+        }
+    }));
+    end_scene(screen);
+}
+
+// One object per type; the first pass over the types builds each control panel (cold),
+// later passes only re-bind the retained panel (warm)
+void scenario_switch_latency(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(kWidgetTypeCount);
+    pump();
+    // Spawning already built every panel; drop them so the first pass measures a full build
+    Bench::drop_control_panels();
+    out.push_back(run_counted("switch_cold", [&](BenchResult& r) {
+        for (int i = 0; i < kWidgetTypeCount; i++) {
+            measure(r, [&] { Bench::select(i); });
+        }
+    }));
+    out.push_back(run_counted("switch_warm", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            int index = i % kWidgetTypeCount;
+            measure(r, [&] { Bench::select(index); });
+        }
+    }));
+    end_scene(screen);
+}
+
+// Switch objects by tapping the chips in the object list through the scripted pointer
+void scenario_tap_chips(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    out.push_back(run_counted("tap_object_chip", [&](BenchResult& r) {
+        lv_obj_t* strip = Bench::object_strip();
+        for (int i = 0; i < cfg.switches; i++) {
+            int index = (i * 7) % cfg.widgets;
+            lv_obj_scroll_to_x(strip, index * Bench::chip_pitch(), LV_ANIM_OFF);
+            pump();
+            lv_obj_t* chip = Bench::chip_for(index);
+            if (!chip) continue;
+            Clock::time_point t0 = Clock::now();
+            tap(chip);
+            r.op_us += elapsed_us(t0);
+            r.ops++;
+        }
+    }));
+    end_scene(screen);
+}
+
+// What the overlay costs a build that never opens it (init only), then the deferred
+// build on first open and a warm close/open afterwards
+void scenario_startup(const BenchConfig&, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_screen_load(screen);
+    pump();
+    out.push_back(run_counted("startup_init", [&](BenchResult& r) {
+        measure(r, [&] { DebugAlignmentEnhanced::init(screen); });
+    }));
+    if (Bench::panel_built()) {
+        fprintf(stderr, "[BENCH] warning: panel was built before the first open\n");
+    }
+    out.push_back(run_counted("startup_first_open", [&](BenchResult& r) {
+        measure(r, [&] { DebugAlignmentEnhanced::toggle(); });
+    }));
+    out.push_back(run_counted("startup_reopen", [&](BenchResult& r) {
+        measure(r, [&] { DebugAlignmentEnhanced::toggle(); });
+        measure(r, [&] { DebugAlignmentEnhanced::toggle(); });
+    }));
+    end_scene(screen);
+}
+
+// RAM cost of the overlay itself: init, opening the panel, and one control panel
+// per widget type. The widgets are spawned first so only panel trees are counted.
+void scenario_panel_heap(const BenchConfig&, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_screen_load(screen);
+    pump();
+    out.push_back(run_counted("heap_init", [&](BenchResult& r) {
+        measure(r, [&] { DebugAlignmentEnhanced::init(screen); });
+    }));
+    out.push_back(run_counted("heap_open_panel", [&](BenchResult& r) {
+        measure(r, [&] { tap(Bench::toggle_button()); });
+    }));
+    spawn_many(kWidgetTypeCount);
+    pump();
+    Bench::drop_control_panels();
+    pump();
+    out.push_back(run_counted("heap_control_panels", [&](BenchResult& r) {
+        for (int i = 0; i < kWidgetTypeCount; i++) {
+            measure(r, [&] { Bench::select(i); });
+        }
+    }));
+    // Tabs other than Transform are only built when first shown
+    out.push_back(run_counted("heap_other_tabs", [&](BenchResult& r) {
+        for (int i = 0; i < kWidgetTypeCount; i++) {
+            Bench::select(i);
+            pump();
+            for (int tab = 1; tab < Bench::control_tab_count(); tab++) {
+                lv_obj_t* button = Bench::tab_button(static_cast<Bench::WidgetType>(i), tab);
+                Clock::time_point t0 = Clock::now();
+                tap(button);
+                r.op_us += elapsed_us(t0);
+                r.ops++;
+            }
+        }
+    }));
+    end_scene(screen);
+}
+
+// Per-object storage: the overlay's own record (slot map, not the LVGL heap) and the
+// LVGL heap each spawned widget adds. Scene RAM is roughly widgets * both.
+void scenario_object_size(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    printf("[BENCH] sizeof: SpawnedObject %zu, WidgetProps %zu (arc %zu, bar %zu, toggle %zu, "
+           "canvas %zu, chart %zu, table %zu, spinner %zu, spinbox %zu, msgbox %zu, pie %zu)\n",
+           Bench::object_record_size(), sizeof(WidgetProps), sizeof(ArcProps), sizeof(BarProps),
+           sizeof(ToggleProps), sizeof(CanvasProps), sizeof(ChartProps), sizeof(TableProps),
+           sizeof(SpinnerProps), sizeof(SpinboxProps), sizeof(MsgBoxProps), sizeof(PieProps));
+    lv_obj_t* screen = begin_scene();
+    BenchResult result = run_counted("spawn_heap", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.widgets; i++) {
+            measure(r, [&] { Bench::spawn(static_cast<Bench::WidgetType>(i % kWidgetTypeCount)); });
+        }
+    });
+    printf("[BENCH] %d objects: %zu bytes record + %lld bytes LVGL heap per object\n", cfg.widgets,
+           Bench::object_record_size(), (long long)(result.heap_bytes / (cfg.widgets ? cfg.widgets : 1)));
+    out.push_back(result);
+    end_scene(screen);
+}
+
+// One object of each type: the heap the overlay charges to each object, summed into the
+// scene's RAM bill, next to the heap growth the harness sees (which also holds the panel's
+// control panels built on selection)
+void scenario_memory_bill(const BenchConfig&, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    lv_obj_t* screen = begin_scene();
+    BenchResult result = run_counted("memory_bill_spawn", [&](BenchResult& r) {
+        for (int i = 0; i < kWidgetTypeCount; i++) {
+            measure(r, [&] { Bench::spawn(static_cast<Bench::WidgetType>(i)); });
+        }
+    });
+    out.push_back(result);
+    for (int i = 0; i < DA::get_spawned_count(); i++) {
+        DA::ObjectHandle handle = DA::get_object_at(i);
+        printf("[BENCH] memory_bill %-14s %7d B\n", Bench::object_name(handle), (int)DA::get_object_ram(handle));
+    }
+    printf("[BENCH] memory_bill: scene %zu B charged to objects, harness saw %lld B of heap growth\n",
+           DA::get_scene_ram(), (long long)result.heap_bytes);
+    // Back rebuilds the spawn menu and its reports; none of that is the object's
+    Bench::select(0);
+    pump();
+    DA::ObjectHandle first = DA::get_object_at(0);
+    int32_t before = DA::get_object_ram(first);
+    Bench::journaled(Bench::back_handler());
+    pump();
+    if (DA::get_object_ram(first) != before) {
+        fprintf(stderr, "[BENCH] warning: Back charged %d B of panel heap to %s\n",
+                (int)(DA::get_object_ram(first) - before), Bench::object_name(first));
+    }
+    end_scene(screen);
+}
+
+// Taps on the panel toggle and the object chips through the scripted pointer, each one a
+// traced handler followed by the refresh that shows it, then the trace written to a file
+void scenario_event_trace(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    const char* path = "debug_alignment_bench_trace.json";
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    DA::clear_trace();
+    out.push_back(run_counted("trace_taps", [&](BenchResult& r) {
+        lv_obj_t* strip = Bench::object_strip();
+        for (int i = 0; i < cfg.switches; i++) {
+            int index = (i * 7) % cfg.widgets;
+            lv_obj_scroll_to_x(strip, index * Bench::chip_pitch(), LV_ANIM_OFF);
+            pump();
+            lv_obj_t* chip = Bench::chip_for(index);
+            if (!chip) continue;
+            Clock::time_point t0 = Clock::now();
+            tap(chip);
+            r.op_us += elapsed_us(t0);
+            r.ops++;
+        }
+        measure(r, [&] { tap(Bench::toggle_button()); });
+        measure(r, [&] { tap(Bench::toggle_button()); });
+    }));
+    out.push_back(run_counted("trace_export", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        if (!DA::export_trace(path)) fprintf(stderr, "[BENCH] warning: event trace export failed\n");
+        r.op_us += elapsed_us(t0);
+        r.ops++;
+    }));
+    printf("[BENCH] event_trace: %zu records buffered, %llu recorded\n", Bench::trace_buffered(),
+           (unsigned long long)Bench::trace_recorded());
+    remove(path);
+    end_scene(screen);
+}
+
+// Hit testing and neighbour queries over a scattered scene (try --widgets 1000):
+// linear scan of LVGL coordinates vs the grid index
+void scenario_spatial(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    uint32_t seed = 12345;
+    auto next = [&seed](int32_t range) {
+        seed = seed * 1103515245u + 12345u;
+        return (int32_t)((seed >> 8) % (uint32_t)range);
+    };
+    for (int i = 0; i < cfg.widgets; i++) {
+        Bench::place(i, next(kScreenWidth) - 100, next(kScreenHeight) - 100);
+    }
+    pump();
+    
+    const int queries = cfg.switches * 10;
+    std::vector<lv_point_t> points(queries);
+    for (auto& p : points) {
+        p.x = next(kScreenWidth);
+        p.y = next(kScreenHeight);
+    }
+    // Both pickers must agree; results are compared after timing
+    std::vector<DA::ObjectHandle> linear_hits(queries);
+    std::vector<DA::ObjectHandle> grid_hits(queries);
+    out.push_back(run_counted("pick_linear", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < queries; i++) linear_hits[i] = Bench::pick_linear(points[i].x, points[i].y);
+        r.op_us += elapsed_us(t0);
+        r.ops += queries;
+    }));
+    out.push_back(run_counted("pick_grid", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < queries; i++) grid_hits[i] = DA::pick_object(points[i].x, points[i].y);
+        r.op_us += elapsed_us(t0);
+        r.ops += queries;
+    }));
+    out.push_back(run_counted("find_objects_grid", [&](BenchResult& r) {
+        std::vector<DA::ObjectHandle> hits;
+        Clock::time_point t0 = Clock::now();
+        for (const auto& p : points) {
+            lv_area_t area = {p.x, p.y, p.x + 99, p.y + 99};
+            hits.clear();
+            DA::find_objects(area, hits);
+        }
+        r.op_us += elapsed_us(t0);
+        r.ops += queries;
+    }));
+    out.push_back(run_counted("nearest_edge_grid", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        for (const auto& p : points) DA::find_nearest_edge(p.x, p.y, 200);
+        r.op_us += elapsed_us(t0);
+        r.ops += queries;
+    }));
+    int mismatches = 0;
+    for (int i = 0; i < queries; i++) {
+        if (linear_hits[i] != grid_hits[i]) mismatches++;
+    }
+    if (mismatches) fprintf(stderr, "[BENCH] warning: %d grid picks disagree with the linear scan\n", mismatches);
+    end_scene(screen);
+}
+
+// Nudges through a scattered scene with guide snapping off, then on: the difference is
+// the edge index lookup plus guide redraws
+void scenario_guide_snap(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    uint32_t seed = 777;
+    auto next = [&seed](int32_t range) {
+        seed = seed * 1103515245u + 12345u;
+        return (int32_t)((seed >> 8) % (uint32_t)range);
+    };
+    for (int i = 0; i < cfg.widgets; i++) {
+        Bench::place(i, next(kScreenWidth - 200), next(kScreenHeight - 200));
+    }
+    pump();
+    const struct {
+        const char* name;
+        bool enabled;
+    } runs[] = {
+        {"nudge_no_guides", false},
+        {"nudge_guides", true},
+    };
+    for (const auto& run : runs) {
+        Bench::set_guide_snap(run.enabled);
+        out.push_back(run_counted(run.name, [&](BenchResult& r) {
+            for (int i = 0; i < cfg.switches; i++) {
+                Bench::select(i % cfg.widgets);
+                pump();
+                for (int m = 0; m < cfg.moves; m++) {
+                    measure(r, (m / 8) % 2 ? Bench::move_down : Bench::move_right);
+                }
+            }
+        }));
+    }
+    Bench::set_guide_snap(true);
+    end_scene(screen);
+}
+
+// Edits through the journal, then unwinding them all and replaying them. Runs of the
+// same move merge, so --moves edits per object become a handful of entries.
+void scenario_undo(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    spawn_many(kWidgetTypeCount);
+    pump();
+    const lv_event_cb_t edits[] = {Bench::move_right_handler(), Bench::move_down_handler(),
+                                   Bench::resize_wider_handler()};
+    out.push_back(run_counted("journaled_edit", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            Bench::select(i % kWidgetTypeCount);
+            pump();
+            for (int m = 0; m < cfg.moves; m++) {
+                lv_event_cb_t edit = edits[(m / 10) % 3];
+                measure(r, [&] { Bench::journaled(edit); });
+            }
+        }
+    }));
+    printf("[BENCH] journal: %zu bytes after %d edits\n", Bench::journal_bytes(), cfg.switches * cfg.moves);
+    out.push_back(run_counted("undo", [&](BenchResult& r) {
+        bool more = true;
+        while (more) measure(r, [&] { more = Bench::undo(); });
+    }));
+    out.push_back(run_counted("redo", [&](BenchResult& r) {
+        bool more = true;
+        while (more) measure(r, [&] { more = Bench::redo(); });
+    }));
+    // Two flags of one record switched on in a row are separate edits: one undo reverts
+    // only the second
+    const int button = (int)Bench::WidgetType::BUTTON;
+    Bench::select(button);
+    Bench::journaled(Bench::button_state_handler());
+    Bench::journaled(Bench::button_disabled_handler());
+    Bench::undo();
+    const ToggleProps* toggle = Bench::toggle_props(button);
+    if (!toggle || !toggle->state || toggle->disabled) {
+        fprintf(stderr, "[BENCH] warning: undo of Disabled did not leave State on its own\n");
+    }
+    end_scene(screen);
+}
+
+// Save a scattered scene of --widgets objects (try 1000), then load it back in one
+// batch; compare scene_load with the spawn scenario's per-object cost
+void scenario_scene_io(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    const char* path = "debug_alignment_bench.scene";
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    uint32_t seed = 54321;
+    for (int i = 0; i < cfg.widgets; i++) {
+        seed = seed * 1103515245u + 12345u;
+        Bench::place(i, (int32_t)((seed >> 8) % kScreenWidth) - 100, (int32_t)((seed >> 16) % kScreenHeight) - 100);
+    }
+    pump();
+    
+    bool saved = false;
+    out.push_back(run_counted("scene_save", [&](BenchResult& r) {
+        measure(r, [&] { saved = DA::save_scene(path); });
+    }));
+    bool loaded = false;
+    out.push_back(run_counted("scene_load", [&](BenchResult& r) {
+        measure(r, [&] { loaded = DA::load_scene(path); });
+    }));
+    if (!saved || !loaded || DA::get_spawned_count() != cfg.widgets) {
+        fprintf(stderr, "[BENCH] warning: scene round trip restored %d of %d objects\n", DA::get_spawned_count(),
+                cfg.widgets);
+    }
+    if (FILE* file = fopen(path, "rb")) {
+        fseek(file, 0, SEEK_END);
+        printf("[BENCH] scene: %ld bytes for %d objects\n", ftell(file), cfg.widgets);
+        fclose(file);
+    }
+    remove(path);
+    end_scene(screen);
+}
+
+// Whole-scene #define export of --widgets objects to a file, --switches times
+void scenario_export(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    const char* path = "debug_alignment_bench_export.h";
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    bool ok = true;
+    out.push_back(run_counted("export_scene", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < cfg.switches; i++) ok = DA::export_scene(path) && ok;
+        r.op_us += elapsed_us(t0);
+        r.ops += cfg.switches;
+    }));
+    if (!ok) fprintf(stderr, "[BENCH] warning: export to %s failed\n", path);
+    if (FILE* file = fopen(path, "rb")) {
+        fseek(file, 0, SEEK_END);
+        printf("[BENCH] export: %ld bytes for %d objects\n", ftell(file), cfg.widgets);
+        fclose(file);
+    }
+    remove(path);
+    end_scene(screen);
+}
+
+// Creation code for --widgets objects: first full generation, then --switches runs
+// that each follow a single-object move, then runs with nothing changed
+void scenario_codegen(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    const char* path = "debug_alignment_bench_scene.c";
+    lv_obj_t* screen = begin_scene();
+    spawn_many(cfg.widgets);
+    pump();
+    remove(path);
+    bool ok = true;
+    out.push_back(run_counted("codegen_full", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        ok = DA::generate_code(path) && ok;
+        r.op_us += elapsed_us(t0);
+        r.ops++;
+    }));
+    out.push_back(run_counted("codegen_one_changed", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            Bench::place(i % cfg.widgets, 10 + i % 200, 20 + i % 100);
+            Clock::time_point t0 = Clock::now();
+            ok = DA::generate_code(path) && ok;
+            r.op_us += elapsed_us(t0);
+            r.ops++;
+        }
+    }));
+    out.push_back(run_counted("codegen_unchanged", [&](BenchResult& r) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < cfg.switches; i++) ok = DA::generate_code(path) && ok;
+        r.op_us += elapsed_us(t0);
+        r.ops += cfg.switches;
+    }));
+    if (!ok) fprintf(stderr, "[BENCH] warning: code generation into %s failed\n", path);
+    if (FILE* file = fopen(path, "rb")) {
+        fseek(file, 0, SEEK_END);
+        printf("[BENCH] codegen: %ld bytes for %d objects\n", ftell(file), cfg.widgets);
+        fclose(file);
+    }
+    remove(path);
+    end_scene(screen);
+}
+
+// Canvas buffers from the pool: fresh allocations, format switches, then the same
+// canvases respawned out of the parked buffers
+void scenario_canvas_pool(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using DA = DebugAlignmentEnhanced;
+    lv_obj_t* screen = begin_scene();
+    out.push_back(run_counted("canvas_spawn", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.widgets; i++) {
+            measure(r, [] { Bench::spawn(Bench::WidgetType::CANVAS); });
+        }
+    }));
+    out.push_back(run_counted("canvas_format_switch", [&](BenchResult& r) {
+        // Every third canvas stays RGB565, the rest move to ARGB8888 or on to L8
+        for (int i = 0; i < cfg.widgets; i++) {
+            Bench::select(i);
+            for (int step = 0; step < i % CanvasBufferPool::FORMAT_COUNT; step++) {
+                measure(r, [] { Bench::journaled(Bench::canvas_format_handler()); });
+            }
+        }
+    }));
+    for (int i = 0; i < CanvasBufferPool::FORMAT_COUNT; i++) {
+        CanvasBufferPool::Usage usage = DA::get_canvas_memory(i);
+        printf("[BENCH] canvas_pool: %-8s %4d buffers %9zu bytes\n", CanvasBufferPool::format_name(i),
+               usage.buffers, usage.bytes);
+    }
+    out.push_back(run_counted("canvas_respawn", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            Bench::select(0);
+            measure(r, [] {
+                Bench::delete_active();
+                Bench::spawn(Bench::WidgetType::CANVAS);
+            });
+        }
+    }));
+    CanvasBufferPool::Usage spare = DA::get_canvas_spare();
+    printf("[BENCH] canvas_pool: %d spare buffers, %zu bytes\n", spare.buffers, spare.bytes);
+    end_scene(screen);
+}
+
+// Pattern fill rate per color format, vectorized against scalar, straight into a
+// 480x320 buffer; then one canvas per format repainted every frame, with the paint
+// (op) and the refresh that draws and flushes it (render) timed apart
+void scenario_canvas_fill(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    const uint32_t width = 480;
+    const uint32_t height = 320;
+    std::vector<uint8_t> pixels(CanvasBufferPool::buffer_size(width, height, LV_COLOR_FORMAT_ARGB8888));
+    for (int format = 0; format < CanvasBufferPool::FORMAT_COUNT; format++) {
+        PatternTarget target;
+        target.data = pixels.data();
+        target.width = width;
+        target.height = height;
+        target.stride = lv_draw_buf_width_to_stride(width, CanvasBufferPool::format_at(format));
+        target.format = static_cast<PatternFormat>(format);
+        for (int p = 0; p < (int)TestPattern::COUNT; p++) {
+            TestPattern pattern = static_cast<TestPattern>(p);
+            double rate[2];
+            for (int scalar = 0; scalar < 2; scalar++) {
+                Clock::time_point t0 = Clock::now();
+                for (int i = 0; i < cfg.frames; i++) {
+                    if (scalar) {
+                        pattern_fill_scalar(target, pattern, 0x3498DB, (uint32_t)i);
+                    } else {
+                        pattern_fill(target, pattern, 0x3498DB, (uint32_t)i);
+                    }
+                }
+                double us = elapsed_us(t0);
+                rate[scalar] = us > 0 ? (double)width * height * cfg.frames / us : 0;  // Mpx/s
+            }
+            printf("[BENCH] canvas_fill %-8s %-12s %6s %8.1f Mpx/s  scalar %8.1f Mpx/s\n",
+                   CanvasBufferPool::format_name(format), pattern_name(pattern), pattern_fill_isa(), rate[0], rate[1]);
+        }
+    }
+    
+    static const char* const paint_names[CanvasBufferPool::FORMAT_COUNT] = {
+        "canvas_paint_rgb565", "canvas_paint_argb8888", "canvas_paint_l8"};
+    for (int format = 0; format < CanvasBufferPool::FORMAT_COUNT; format++) {
+        lv_obj_t* screen = begin_scene();
+        Bench::spawn(Bench::WidgetType::CANVAS);
+        for (int step = 0; step < format; step++) Bench::journaled(Bench::canvas_format_handler());
+        pump();
+        out.push_back(run_counted(paint_names[format], [&](BenchResult& r) {
+            for (int i = 0; i < cfg.frames; i++) {
+                measure(r, [] { Bench::paint_canvas(0, TestPattern::NOISE); });
+            }
+        }));
+        end_scene(screen);
+    }
+}
+
+// One chart fed at increasing rates in both update modes; frames are pumped in LVGL
+// time, so the achieved rate is what the feeder manages per simulated second
+void scenario_chart_feed(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    static const struct {
+        const char* name;
+        int rate;
+        int mode;
+    } runs[] = {
+        {"chart_feed_100_circular", 100, 0},
+        {"chart_feed_1k_circular", 1000, 0},
+        {"chart_feed_10k_circular", 10000, 0},
+        {"chart_feed_100_shift", 100, 1},
+        {"chart_feed_1k_shift", 1000, 1},
+        {"chart_feed_10k_shift", 10000, 1},
+    };
+    for (const auto& run : runs) {
+        lv_obj_t* screen = begin_scene();
+        Bench::spawn(Bench::WidgetType::CHART);
+        Bench::set_chart(0, 1000, run.rate, run.mode);
+        pump();
+        out.push_back(run_counted(run.name, [&](BenchResult& r) {
+            for (int i = 0; i < cfg.frames; i++) {
+                measure(r, [] {});
+            }
+        }));
+        if (const auto* feed = Bench::chart_feed(0)) {
+            // The share-of-time figure is left out: draws are wall time, the window is LVGL time
+            printf("[BENCH] %s: %u points/s achieved, chart draw %u us per pass\n", run.name,
+                   (unsigned)feed->points_per_sec, (unsigned)feed->draw_us);
+        }
+        end_scene(screen);
+    }
+}
+
+// A shift-mode line chart at 1k, 10k and 100k points, drawing every sample and then a
+// min/max pair per pixel column. Each run feeds one whole window per second, so every
+// frame takes new samples and redraws the chart.
+void scenario_chart_decimation(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    static const struct {
+        const char* name;
+        int points;
+        int decimate;
+    } runs[] = {
+        {"chart_1k_every_sample", 1000, 0},
+        {"chart_1k_min_max", 1000, 1},
+        {"chart_10k_every_sample", 10000, 0},
+        {"chart_10k_min_max", 10000, 1},
+        {"chart_100k_every_sample", 100000, 0},
+        {"chart_100k_min_max", 100000, 1},
+    };
+    for (const auto& run : runs) {
+        lv_obj_t* screen = begin_scene();
+        Bench::spawn(Bench::WidgetType::CHART);
+        Bench::set_chart(0, run.points, run.points, 1, run.decimate);
+        // Fill the window before timing
+        for (uint32_t t = 0; t <= 1000; t += kFrameMs) pump();
+        out.push_back(run_counted(run.name, [&](BenchResult& r) {
+            for (int i = 0; i < cfg.frames; i++) {
+                measure(r, [] {});
+            }
+        }));
+        if (const auto* feed = Bench::chart_feed(0)) {
+            printf("[BENCH] %s: %u chart points per series, chart draw %u us per pass\n", run.name,
+                   (unsigned)Bench::chart_point_count(0), (unsigned)feed->draw_us);
+        }
+        end_scene(screen);
+    }
+}
+
+// A spinner animating under the open panel, timed by the harness and by the panel's
+// own frame strip; the two should agree on what a frame costs
+void scenario_perf_strip(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    Bench::spawn(Bench::WidgetType::SPINNER);
+    pump();
+    Bench::perf_reset();  // The strip's history then only holds the frames below
+    BenchResult result = run_counted("perf_strip_spinner", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.frames; i++) {
+            measure(r, [] {});
+        }
+    });
+    Bench::PerfSummary strip = Bench::perf_summary();
+    out.push_back(result);
+    if (strip.frames && result.frames) {
+        printf("[BENCH] perf_strip: strip %u frames, %llu us render + %llu us flush, %llu px per frame; "
+               "harness %u frames, %llu px per frame\n",
+               (unsigned)strip.frames, (unsigned long long)(strip.render_us / strip.frames),
+               (unsigned long long)(strip.flush_us / strip.frames), (unsigned long long)(strip.pixels / strip.frames),
+               (unsigned)result.frames, (unsigned long long)(result.pixels / result.frames));
+    }
+    end_scene(screen);
+}
+
+// A spinner and a still button under the redraw heatmap: the spinner's cells should
+// come out hot and the button's cold
+void scenario_redraw_heatmap(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    Bench::spawn(Bench::WidgetType::SPINNER);
+    Bench::place(0, -150, 80);
+    Bench::spawn(Bench::WidgetType::BUTTON);
+    Bench::place(1, 150, 80);
+    pump();
+    DebugAlignmentEnhanced::set_redraw_heatmap(true);
+    BenchResult result = run_counted("redraw_heatmap_spinner", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.frames; i++) {
+            measure(r, [] {});
+        }
+    });
+    out.push_back(result);
+    const RedrawHeatmap& heat = Bench::redraw_heatmap();
+    int32_t col = -1;
+    int32_t row = -1;
+    heat.hottest(col, row);
+    if (heat.frames() && col >= 0) {
+        lv_area_t cell = heat.cell_area(col, row);
+        printf("[BENCH] redraw_heatmap: %u frames, %llu px per frame, hottest cell at %d,%d level %u/%u\n",
+               (unsigned)heat.frames(), (unsigned long long)(heat.total_pixels() / heat.frames()), (int)cell.x1,
+               (int)cell.y1, (unsigned)heat.level(col, row), (unsigned)RedrawHeatmap::FULL);
+    }
+    DebugAlignmentEnhanced::set_redraw_heatmap(false);
+    end_scene(screen);
+}
+
+// The combinations the ranking is for (arc with rounded caps, rotated button, button at
+// 40% opacity) next to a plain button and a spinner, measured with the panel closed
+void scenario_render_cost(const BenchConfig&, std::vector<BenchResult>& out) {
+    lv_obj_t* screen = begin_scene();
+    const struct {
+        Bench::WidgetType type;
+        int32_t x;
+        int32_t y;
+    } layout[] = {
+        {Bench::WidgetType::BUTTON, 20, 20},  {Bench::WidgetType::ARC, 300, 20},
+        {Bench::WidgetType::BUTTON, 20, 300}, {Bench::WidgetType::BUTTON, 300, 300},
+        {Bench::WidgetType::SPINNER, 560, 20},
+    };
+    for (int i = 0; i < (int)(sizeof(layout) / sizeof(layout[0])); i++) {
+        Bench::spawn(layout[i].type);
+        Bench::place(i, layout[i].x, layout[i].y);
+    }
+    Bench::set_rounded_caps(1);
+    Bench::set_rotation(2, 30);
+    Bench::set_opacity(3, LV_OPA_40);
+    DebugAlignmentEnhanced::toggle();
+    pump();
+
+    out.push_back(run_counted("render_cost_measure", [&](BenchResult& r) {
+        DebugAlignmentEnhanced::measure_render_costs();
+        r.ops = 1;
+    }));
+    int rank = 0;
+    for (const auto& cost : DebugAlignmentEnhanced::get_render_costs()) {
+        printf("[BENCH] render_cost %d. %-12s %6u us (shown %u, hidden %u)\n", ++rank, Bench::object_name(cost.handle),
+               (unsigned)cost.cost_us(), (unsigned)cost.shown_us, (unsigned)cost.hidden_us);
+    }
+    end_scene(screen);
+}
+
+// Full-screen redraws with the panel open over live widgets, once per render profile
+void scenario_render_profile(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    using Profile = DebugAlignmentEnhanced::RenderProfile;
+    const Profile initial = DebugAlignmentEnhanced::get_render_profile();
+    const struct {
+        const char* name;
+        Profile profile;
+    } runs[] = {
+        {"frame_rich", Profile::RICH},
+        {"frame_low_overhead", Profile::LOW_OVERHEAD},
+    };
+    for (const auto& run : runs) {
+        DebugAlignmentEnhanced::set_render_profile(run.profile);
+        lv_obj_t* screen = begin_scene();
+        spawn_many(kWidgetTypeCount);
+        pump();
+        out.push_back(run_counted(run.name, [&](BenchResult& r) {
+            for (int i = 0; i < cfg.frames; i++) {
+                measure(r, [&] { lv_obj_invalidate(screen); });
+            }
+        }));
+        end_scene(screen);
+    }
+    DebugAlignmentEnhanced::set_render_profile(initial);
+}
+
+// Cost a handler pays per log call: formatting into the ring only, no output
+void scenario_log_write(const BenchConfig& cfg, std::vector<BenchResult>& out) {
+    out.push_back(run_counted("log_write", [&](BenchResult& r) {
+        for (int i = 0; i < cfg.switches; i++) {
+            Clock::time_point t0 = Clock::now();
+            DA_LOGD("MOVE %s: %d -> %d", "RIGHT", i, i + 2);
+            r.op_us += elapsed_us(t0);
+            r.ops++;
+            // Drain outside the timed region, as the timer would
+            if ((i & 31) == 31) DebugAlignmentLog::drain();
+        }
+        DebugAlignmentLog::drain();
+    }));
+}
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    void (*run)(const BenchConfig&, std::vector<BenchResult>&);
+};
+
+const Scenario scenarios[] = {
+    {"spawn", "spawn --widgets widgets, cycling through every type", scenario_spawn},
+    {"move", "move each of --widgets widgets --moves times", scenario_move},
+    {"move_burst", "--moves moves per frame on --switches objects (coalesced transforms)", scenario_move_burst},
+    {"switch", "switch the active object --switches times", scenario_switch},
+    {"switch_latency", "cold (first build) vs warm (retained) control panel switches", scenario_switch_latency},
+    {"delete", "delete --widgets objects, always the first in the list", scenario_delete},
+    {"object_list", "rebuild the object list --switches times", scenario_object_list},
+    {"tap_chips", "select objects by tapping list chips --switches times", scenario_tap_chips},
+    {"render_profile", "full redraws (--frames) with the panel open, rich vs low-overhead look", scenario_render_profile},
+    {"log_write", "--switches debug log calls into the ring (drained untimed)", scenario_log_write},
+    {"startup", "init cost with the panel closed, first open, and a warm reopen", scenario_startup},
+    {"panel_heap", "LVGL heap used by init, the open panel and all control panels", scenario_panel_heap},
+    {"spatial", "pick / area / nearest-edge queries over --widgets scattered objects", scenario_spatial},
+    {"guide_snap", "--moves nudges on --switches objects, guide snapping off vs on", scenario_guide_snap},
+    {"undo", "--moves journaled edits on --switches objects, then undo and redo everything", scenario_undo},
+    {"scene_io", "save --widgets scattered objects to a scene file and load it back", scenario_scene_io},
+    {"export", "export all --widgets objects as #defines to a file, --switches times", scenario_export},
+    {"codegen", "generate creation code for --widgets objects: full, after one move, unchanged", scenario_codegen},
+    {"canvas_pool", "spawn --widgets canvases, switch formats, respawn --switches from the pool", scenario_canvas_pool},
+    {"canvas_fill", "test pattern Mpx/s per color format (SIMD vs scalar), canvas paint vs refresh", scenario_canvas_fill},
+    {"chart_feed", "1000-point chart fed at 100 to 10k samples/s, circular and shift (--frames frames)", scenario_chart_feed},
+    {"chart_decimation", "line chart at 1k/10k/100k points, every sample vs min/max per column (--frames frames)",
+     scenario_chart_decimation},
+    {"perf_strip", "spinner under the open panel, harness vs frame strip timing (--frames frames)",
+     scenario_perf_strip},
+    {"redraw_heatmap", "spinner and still button under the redraw heatmap, hottest cell (--frames frames)",
+     scenario_redraw_heatmap},
+    {"render_cost", "per-object render cost ranking: rounded arc, rotated and 40% opacity buttons", scenario_render_cost},
+    {"memory_bill", "LVGL heap charged to one object of each type vs the harness's heap growth", scenario_memory_bill},
+    {"event_trace", "--switches traced chip taps and two panel toggles, then the Chrome trace export", scenario_event_trace},
+    {"object_size", "per-object record size and LVGL heap for --widgets spawned objects", scenario_object_size},
+};
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+void print_results(const std::vector<BenchResult>& results, bool csv) {
+    if (csv) {
+        printf("scenario,ops,op_us_total,op_us_per_op,render_us_per_op,frames,pixels,heap_bytes\n");
+        for (const auto& r : results) {
+            double n = r.ops ? (double)r.ops : 1.0;
+            printf("%s,%u,%.1f,%.2f,%.2f,%u,%llu,%lld\n", r.name.c_str(), r.ops, r.op_us,
+                   r.op_us / n, r.render_us / n, r.frames, (unsigned long long)r.pixels,
+                   (long long)r.heap_bytes);
+        }
+        return;
+    }
+
+    printf("\n%-22s %8s %12s %14s %8s %12s %12s\n", "scenario", "ops", "us/op", "render us/op", "frames",
+           "px flushed", "heap bytes");
+    printf("-------------------------------------------------------------------------------------------------\n");
+    for (const auto& r : results) {
+        double n = r.ops ? (double)r.ops : 1.0;
+        printf("%-22s %8u %12.2f %14.2f %8u %12llu %12lld\n", r.name.c_str(), r.ops, r.op_us / n,
+               r.render_us / n, r.frames, (unsigned long long)r.pixels, (long long)r.heap_bytes);
+    }
+    printf("\n");
+}
+
+void init_lvgl() {
+    lv_init();
+
+    display = lv_display_create(kScreenWidth, kScreenHeight);
+    lv_display_set_buffers(display, draw_buf, nullptr, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+
+    pointer = lv_indev_create();
+    lv_indev_set_type(pointer, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer, pointer_read_cb);
+}
+
+int parse_int(const char* value, int fallback) {
+    if (!value) return fallback;
+    int v = std::atoi(value);
+    return v > 0 ? v : fallback;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    const char* only = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(arg, "--scenario") && next) { only = next; i++; }
+        else if (!strcmp(arg, "--widgets") && next) { cfg.widgets = parse_int(next, cfg.widgets); i++; }
+        else if (!strcmp(arg, "--moves") && next) { cfg.moves = parse_int(next, cfg.moves); i++; }
+        else if (!strcmp(arg, "--switches") && next) { cfg.switches = parse_int(next, cfg.switches); i++; }
+        else if (!strcmp(arg, "--frames") && next) { cfg.frames = parse_int(next, cfg.frames); i++; }
+        else if (!strcmp(arg, "--csv")) { cfg.csv = true; }
+        else if (!strcmp(arg, "--verbose")) { cfg.verbose = true; }
+        else if (!strcmp(arg, "--list")) {
+            for (const auto& s : scenarios) printf("%-14s %s\n", s.name, s.description);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown argument: %s (try --list)\n", arg);
+            return 2;
+        }
+    }
+
+    init_lvgl();
+    if (!cfg.verbose) {
+        DebugAlignmentLog::set_sink([](const char*, size_t) {});
+    }
+
+    std::vector<BenchResult> results;
+    bool ran = false;
+    for (const auto& s : scenarios) {
+        if (only && strcmp(only, s.name) != 0) continue;
+        s.run(cfg, results);
+        ran = true;
+    }
+    if (!ran) {
+        fprintf(stderr, "No scenario named '%s' (try --list)\n", only ? only : "");
+        return 2;
+    }
+
+    print_results(results, cfg.csv);
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+File:   lv_conf.h
+Author: Will Jenkins
+Purpose: LVGL configuration for the headless benchmark build (Linux, no OS layer, no GPU)
+*/
+
+#if 1 /* Set it to "1" to enable content */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* Match the RGB565 panels we flash so render costs are comparable */
+#define LV_COLOR_DEPTH 16
+
+/* Builtin allocator so lv_mem_monitor() reports what the overlay costs */
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_STRING    LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
+#define LV_MEM_SIZE (8 * 1024 * 1024U)  /* Room for large scenes plus the panel */
+
+#define LV_DEF_REFR_PERIOD 33
+#define LV_DPI_DEF 130
+
+#define LV_USE_OS LV_OS_NONE
+#define LV_USE_LOG 0
+#define LV_USE_SYSMON 0
+
+/* Fonts used by the overlay */
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_16 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_32 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+
+#define LV_BUILD_EXAMPLES 0
+
+#endif /* LV_CONF_H */
+
+#endif /* End of "Content enable" */
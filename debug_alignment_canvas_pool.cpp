@@ -0,0 +1,181 @@
+/*
+File:   debug_alignment_canvas_pool.cpp
+Author: Will Jenkins
+Purpose: Per-canvas draw buffers from the LVGL heap, with reuse of freed buffers
+*/
+
+#include "debug_alignment_canvas_pool.hpp"
+#include <algorithm>
+
+namespace {
+
+const lv_color_format_t pool_formats[CanvasBufferPool::FORMAT_COUNT] = {
+    LV_COLOR_FORMAT_RGB565,
+    LV_COLOR_FORMAT_ARGB8888,
+    LV_COLOR_FORMAT_L8,
+};
+const char* const pool_format_names[CanvasBufferPool::FORMAT_COUNT] = {"RGB565", "ARGB8888", "L8"};
+
+}  // namespace
+
+lv_color_format_t CanvasBufferPool::format_at(int index) {
+    return index >= 0 && index < FORMAT_COUNT ? pool_formats[index] : pool_formats[0];
+}
+
+const char* CanvasBufferPool::format_name(int index) {
+    return index >= 0 && index < FORMAT_COUNT ? pool_format_names[index] : pool_format_names[0];
+}
+
+int CanvasBufferPool::format_index(lv_color_format_t format) {
+    for (int i = 0; i < FORMAT_COUNT; i++) {
+        if (pool_formats[i] == format) return i;
+    }
+    return -1;
+}
+
+size_t CanvasBufferPool::buffer_size(uint32_t width, uint32_t height, lv_color_format_t format) {
+    return (size_t)lv_draw_buf_width_to_stride(width, format) * height;
+}
+
+CanvasBufferPool::Entry* CanvasBufferPool::find(const void* owner) {
+    if (!owner) return nullptr;
+    for (Entry& entry : entries_) {
+        if (entry.owner == owner) return &entry;
+    }
+    return nullptr;
+}
+
+const CanvasBufferPool::Entry* CanvasBufferPool::find(const void* owner) const {
+    if (!owner) return nullptr;
+    for (const Entry& entry : entries_) {
+        if (entry.owner == owner) return &entry;
+    }
+    return nullptr;
+}
+
+bool CanvasBufferPool::matches(const void* owner, uint32_t width, uint32_t height,
+                               lv_color_format_t format) const {
+    const Entry* entry = find(owner);
+    return entry && entry->width == width && entry->height == height && entry->format == format;
+}
+
+CanvasBufferPool::Buffer CanvasBufferPool::buffer(const void* owner) const {
+    Buffer out;
+    if (const Entry* entry = find(owner)) {
+        out.data = entry->data;
+        out.width = entry->width;
+        out.height = entry->height;
+        out.format = entry->format;
+    }
+    return out;
+}
+
+void* CanvasBufferPool::acquire(const void* owner, uint32_t width, uint32_t height, lv_color_format_t format) {
+    size_t bytes = buffer_size(width, height, format);
+    if (Entry* current = find(owner)) {
+        if (current->format == format && current->bytes == bytes) {
+            // Same footprint (possibly reshaped): the canvas keeps its own memory
+            current->width = width;
+            current->height = height;
+            return current->data;
+        }
+    }
+
+    void* data = take_spare(format, bytes);
+    if (!data) data = lv_malloc(bytes);
+    if (!data) {
+        // Spare buffers of other sizes are the first thing to give back
+        free_spare();
+        data = lv_malloc(bytes);
+        // The owner keeps its current buffer
+        if (!data) return nullptr;
+    }
+    release(owner);
+    entries_.push_back(Entry{data, owner, bytes, width, height, format});
+    return data;
+}
+
+void* CanvasBufferPool::take_spare(lv_color_format_t format, size_t bytes) {
+    // Oldest parked buffer of the same format and size first
+    for (size_t i = 0; i < entries_.size(); i++) {
+        const Entry& entry = entries_[i];
+        if (entry.owner || entry.format != format || entry.bytes != bytes) continue;
+        void* data = entry.data;
+        entries_.erase(entries_.begin() + i);
+        return data;
+    }
+    return nullptr;
+}
+
+void CanvasBufferPool::free_spare() {
+    for (Entry& entry : entries_) {
+        if (!entry.owner) lv_free(entry.data);
+    }
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [](const Entry& e) { return !e.owner; }),
+                   entries_.end());
+}
+
+void CanvasBufferPool::release(const void* owner) {
+    if (!owner) return;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i].owner != owner) continue;
+        // Park at the back so reuse and trimming go oldest first
+        Entry parked = entries_[i];
+        parked.owner = nullptr;
+        entries_.erase(entries_.begin() + i);
+        entries_.push_back(parked);
+        trim_spare();
+        return;
+    }
+}
+
+void CanvasBufferPool::trim_spare() {
+    size_t spare_bytes = spare().bytes;
+    for (size_t i = 0; i < entries_.size() && spare_bytes > DEBUG_ALIGNMENT_CANVAS_POOL_SPARE;) {
+        if (entries_[i].owner) {
+            i++;
+            continue;
+        }
+        spare_bytes -= entries_[i].bytes;
+        lv_free(entries_[i].data);
+        entries_.erase(entries_.begin() + i);
+    }
+}
+
+void CanvasBufferPool::clear() {
+    for (Entry& entry : entries_) {
+        lv_free(entry.data);
+    }
+    entries_.clear();
+}
+
+CanvasBufferPool::Usage CanvasBufferPool::in_use(int format_index) const {
+    Usage usage;
+    lv_color_format_t format = format_at(format_index);
+    for (const Entry& entry : entries_) {
+        if (entry.owner && entry.format == format) {
+            usage.buffers++;
+            usage.bytes += entry.bytes;
+        }
+    }
+    return usage;
+}
+
+CanvasBufferPool::Usage CanvasBufferPool::spare() const {
+    Usage usage;
+    for (const Entry& entry : entries_) {
+        if (!entry.owner) {
+            usage.buffers++;
+            usage.bytes += entry.bytes;
+        }
+    }
+    return usage;
+}
+
+size_t CanvasBufferPool::held_bytes() const {
+    size_t bytes = 0;
+    for (const Entry& entry : entries_) {
+        bytes += entry.bytes;
+    }
+    return bytes;
+}
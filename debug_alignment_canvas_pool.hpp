@@ -0,0 +1,85 @@
+/*
+File:   debug_alignment_canvas_pool.hpp
+Author: Will Jenkins
+Purpose: Per-canvas draw buffers from the LVGL heap, with reuse of freed buffers
+*/
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bytes of released buffers kept around for reuse; beyond this the oldest are freed
+#ifndef DEBUG_ALIGNMENT_CANVAS_POOL_SPARE
+#define DEBUG_ALIGNMENT_CANVAS_POOL_SPARE (128 * 1024)
+#endif
+
+// Largest canvas side accepted from props
+#ifndef DEBUG_ALIGNMENT_CANVAS_MAX_SIZE
+#define DEBUG_ALIGNMENT_CANVAS_MAX_SIZE 1024
+#endif
+
+// Each canvas gets its own buffer, sized from its width, height and color format
+// (stride as LVGL computes it). Released buffers are parked and handed to the next
+// canvas asking for the same format and byte size, so recreating or respawning a
+// canvas does not churn the heap.
+class CanvasBufferPool {
+public:
+    // Formats a canvas can be switched between, in CanvasProps::color_format order
+    static constexpr int FORMAT_COUNT = 3;
+    static lv_color_format_t format_at(int index);
+    static const char* format_name(int index);
+    static int format_index(lv_color_format_t format);  // -1 if not one of the above
+
+    struct Usage {
+        int buffers = 0;
+        size_t bytes = 0;
+    };
+
+    static size_t buffer_size(uint32_t width, uint32_t height, lv_color_format_t format);
+
+    // Buffer for owner, replacing whatever it held. Returns the current one if it
+    // already has this format and byte size; nullptr (owner keeps its current
+    // buffer) if the heap is exhausted.
+    void* acquire(const void* owner, uint32_t width, uint32_t height, lv_color_format_t format);
+    // Owner's current buffer (data is nullptr if it has none)
+    struct Buffer {
+        void* data = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        lv_color_format_t format = LV_COLOR_FORMAT_UNKNOWN;
+    };
+    Buffer buffer(const void* owner) const;
+    // Whether owner's buffer already has this size and format
+    bool matches(const void* owner, uint32_t width, uint32_t height, lv_color_format_t format) const;
+    void release(const void* owner);
+    // Frees every buffer, including ones still handed out. Not done on destruction:
+    // the LVGL heap may already be gone by then.
+    void clear();
+
+    // Bytes held by live canvases per format (indexed like format_at), and spare bytes
+    Usage in_use(int format_index) const;
+    Usage spare() const;
+    // Every buffer the pool holds from the LVGL heap, live and spare
+    size_t held_bytes() const;
+
+private:
+    struct Entry {
+        void* data;
+        const void* owner;  // nullptr while parked
+        size_t bytes;
+        uint32_t width;
+        uint32_t height;
+        lv_color_format_t format;
+    };
+
+    Entry* find(const void* owner);
+    const Entry* find(const void* owner) const;
+    void* take_spare(lv_color_format_t format, size_t bytes);
+    void free_spare();
+    void trim_spare();
+
+    std::vector<Entry> entries_;  // Parked entries in release order, oldest first
+};
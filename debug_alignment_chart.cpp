@@ -0,0 +1,472 @@
+/*
+File:   debug_alignment_chart.cpp
+Author: Will Jenkins
+Purpose: Chart property controls and a timer-driven synthetic data feeder for spawned charts
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_clock.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// Feeder tick; each tick pushes every sample that came due since the last one
+#ifndef DEBUG_ALIGNMENT_CHART_FEED_PERIOD
+#define DEBUG_ALIGNMENT_CHART_FEED_PERIOD 10
+#endif
+
+#ifndef DEBUG_ALIGNMENT_CHART_MAX_POINTS
+#define DEBUG_ALIGNMENT_CHART_MAX_POINTS 100000
+#endif
+
+std::vector<DebugAlignmentEnhanced::ChartFeed> DebugAlignmentEnhanced::chart_feeds;
+lv_timer_t* DebugAlignmentEnhanced::chart_feed_timer = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::chart_readout_label = nullptr;
+
+namespace {
+
+constexpr int CHART_MAX_SERIES = 6;
+const lv_palette_t series_palette[CHART_MAX_SERIES] = {
+    LV_PALETTE_RED, LV_PALETTE_BLUE, LV_PALETTE_GREEN, LV_PALETTE_ORANGE, LV_PALETTE_PURPLE, LV_PALETTE_TEAL,
+};
+
+// Feed rates the Rate+/Rate- buttons step through, in samples per second
+const int feed_rates[] = {0, 10, 30, 100, 300, 1000, 3000, 10000, 30000, 100000};
+constexpr int FEED_RATE_COUNT = (int)(sizeof(feed_rates) / sizeof(feed_rates[0]));
+
+constexpr uint32_t READOUT_WINDOW_MS = 1000;
+
+lv_chart_type_t chart_type(int type) {
+    switch (type) {
+        case 1: return LV_CHART_TYPE_BAR;
+        case 2: return LV_CHART_TYPE_SCATTER;
+        default: return LV_CHART_TYPE_LINE;
+    }
+}
+
+// Deterministic trend-like signal: two sines with per-series periods plus a little
+// hashed noise, all a function of the absolute sample index
+int32_t chart_sample(int series, uint64_t index, int32_t y_min, int32_t y_max) {
+    const float two_pi = 6.2831853f;
+    uint32_t slow = 240 + 90 * (uint32_t)series;
+    uint32_t fast = 37 + 11 * (uint32_t)series;
+    float a = two_pi * (float)(index % slow) / (float)slow;
+    float b = two_pi * (float)(index % fast) / (float)fast;
+    uint32_t h = (uint32_t)index * 0x9E3779B9u ^ (uint32_t)(index >> 32) ^ (uint32_t)series * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    float noise = (float)(h & 0xFFFF) / 32767.5f - 1.0f;
+    float level = 0.65f * sinf(a) + 0.2f * sinf(b) + 0.1f * noise;
+    float mid = 0.5f * ((float)y_min + (float)y_max);
+    float half = 0.5f * ((float)y_max - (float)y_min);
+    int32_t value = (int32_t)lrintf(mid + half * level);
+    return std::max(y_min, std::min(y_max, value));
+}
+
+// Samples per pixel column when the chart is decimated, 1 when every sample is drawn.
+// Only line charts are decimated, and only once there are over two samples per column,
+// since each column costs two chart points. The width is read as last laid out; a chart
+// that is resized later gets SIZE_CHANGED, which brings the columns up to date.
+uint32_t chart_samples_per_column(lv_obj_t* obj, const ChartProps& chart) {
+    if (!chart.decimate || chart.chart_type != 0) return 1;
+    int32_t columns = lv_obj_get_content_width(obj);
+    if (columns <= 0) return 1;
+    uint32_t per_column = MinMaxDecimator::samples_per_column((uint32_t)chart.chart_points, (uint32_t)columns);
+    return per_column > 2 ? per_column : 1;
+}
+
+// Writes a column as its two points: appended after the newest point, or over the
+// newest two if the column is already on the chart
+void put_column(lv_obj_t* obj, lv_chart_series_t* ser, const ColumnEnvelope& column, bool replace) {
+    if (!replace) {
+        lv_chart_set_next_value(obj, ser, column.first());
+        lv_chart_set_next_value(obj, ser, column.second());
+        return;
+    }
+    uint32_t count = lv_chart_get_point_count(obj);
+    uint32_t next = lv_chart_get_x_start_point(obj, ser);
+    lv_chart_set_value_by_id(obj, ser, (next + count - 2) % count, column.first());
+    lv_chart_set_value_by_id(obj, ser, (next + count - 1) % count, column.second());
+}
+
+}  // namespace
+
+// Pushes the chart props into LVGL; series are added or dropped at the end to match
+// series_count, so the existing ones keep their data. A decimated chart holds two
+// points per pixel column rather than chart_points.
+void DebugAlignmentEnhanced::apply_chart_props(SpawnedObject& obj) {
+    ChartProps* chart = obj.props_as<ChartProps>();
+    if (!chart || !obj.object) return;
+    chart->chart_points = std::max(2, std::min(chart->chart_points, DEBUG_ALIGNMENT_CHART_MAX_POINTS));
+    chart->series_count = std::max(1, std::min(chart->series_count, CHART_MAX_SERIES));
+    chart->h_div_lines = std::max(0, std::min(chart->h_div_lines, 32));
+    chart->v_div_lines = std::max(0, std::min(chart->v_div_lines, 32));
+    if (chart->y_max <= chart->y_min) chart->y_max = chart->y_min + 1;
+
+    lv_chart_set_type(obj.object, chart_type(chart->chart_type));
+    uint32_t per_column = chart_samples_per_column(obj.object, *chart);
+    uint32_t point_count = per_column > 1
+                               ? 2 * MinMaxDecimator::column_count((uint32_t)chart->chart_points, per_column)
+                               : (uint32_t)chart->chart_points;
+    if (lv_chart_get_point_count(obj.object) != point_count) {
+        lv_chart_set_point_count(obj.object, point_count);
+    }
+    lv_chart_set_range(obj.object, LV_CHART_AXIS_PRIMARY_Y, chart->y_min, chart->y_max);
+    lv_chart_set_div_line_count(obj.object, (uint8_t)chart->h_div_lines, (uint8_t)chart->v_div_lines);
+    lv_chart_set_update_mode(obj.object,
+                             chart->update_mode == 1 ? LV_CHART_UPDATE_MODE_SHIFT : LV_CHART_UPDATE_MODE_CIRCULAR);
+
+    int count = 0;
+    for (lv_chart_series_t* ser = lv_chart_get_series_next(obj.object, nullptr); ser;
+         ser = lv_chart_get_series_next(obj.object, ser)) {
+        count++;
+    }
+    for (; count < chart->series_count; count++) {
+        lv_chart_add_series(obj.object, lv_palette_main(series_palette[count]), LV_CHART_AXIS_PRIMARY_Y);
+    }
+    for (; count > chart->series_count; count--) {
+        lv_chart_series_t* last = nullptr;
+        for (lv_chart_series_t* ser = lv_chart_get_series_next(obj.object, nullptr); ser;
+             ser = lv_chart_get_series_next(obj.object, ser)) {
+            last = ser;
+        }
+        lv_chart_remove_series(obj.object, last);
+    }
+    lv_chart_refresh(obj.object);
+
+    if (chart->feed_rate > 0) start_chart_feed(obj);
+    if (ChartFeed* feed = find_chart_feed(obj.handle)) sync_chart_decimation(obj, *feed, per_column);
+}
+
+// Switching between raw samples and envelopes clears the series, as the two would
+// otherwise share the chart until the window had scrolled through
+void DebugAlignmentEnhanced::sync_chart_decimation(SpawnedObject& obj, ChartFeed& feed, uint32_t per_column) {
+    const ChartProps* chart = obj.props_as<ChartProps>();
+    if (per_column <= 1) per_column = 0;
+    if (feed.per_column != per_column) {
+        feed.per_column = per_column;
+        feed.envelopes.clear();
+        for (lv_chart_series_t* ser = lv_chart_get_series_next(obj.object, nullptr); ser;
+             ser = lv_chart_get_series_next(obj.object, ser)) {
+            lv_chart_set_all_value(obj.object, ser, LV_CHART_POINT_NONE);
+        }
+        DA_LOGD("%s: %s", obj.name.c_str(), per_column ? "decimating" : "drawing every sample");
+    }
+    if (!per_column) return;
+    feed.envelopes.resize(std::min(feed.envelopes.size(), (size_t)chart->series_count));
+    while (feed.envelopes.size() < (size_t)chart->series_count) {
+        feed.envelopes.emplace_back();
+        feed.envelopes.back().decimator.reset(per_column);
+    }
+}
+
+// The column count follows the chart's width. This runs inside a layout pass, so it only
+// notes that the count changed; the next feed tick re-applies the props, once however
+// many size events came in between.
+void DebugAlignmentEnhanced::chart_size_changed_event(lv_event_t* e) {
+    lv_obj_t* target = lv_event_get_current_target_obj(e);
+    for (ChartFeed& feed : chart_feeds) {
+        if (feed.chart != target) continue;
+        const SpawnedObject* obj = spawned_objects.get(feed.handle);
+        const ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+        if (!chart) return;
+        uint32_t per_column = chart_samples_per_column(target, *chart);
+        if ((per_column > 1 ? per_column : 0) != feed.per_column) feed.resized = true;
+        return;
+    }
+}
+
+DebugAlignmentEnhanced::ChartFeed* DebugAlignmentEnhanced::find_chart_feed(ObjectHandle handle) {
+    for (ChartFeed& feed : chart_feeds) {
+        if (feed.handle == handle) return &feed;
+    }
+    return nullptr;
+}
+
+void DebugAlignmentEnhanced::start_chart_feed(SpawnedObject& obj) {
+    if (!obj.handle.valid() || find_chart_feed(obj.handle)) return;
+    ChartFeed feed;
+    feed.handle = obj.handle;
+    feed.chart = obj.object;
+    feed.last_tick = feed.window_start = lv_tick_get();
+    chart_feeds.push_back(feed);
+
+    // Draw passes of this chart are timed for the readout
+    lv_obj_add_event_cb(obj.object, chart_draw_timing_event, LV_EVENT_DRAW_MAIN_BEGIN, nullptr);
+    lv_obj_add_event_cb(obj.object, chart_draw_timing_event, LV_EVENT_DRAW_POST_END, nullptr);
+    lv_obj_add_event_cb(obj.object, chart_size_changed_event, LV_EVENT_SIZE_CHANGED, nullptr);
+
+    if (!chart_feed_timer) {
+        chart_feed_timer = lv_timer_create(chart_feed_timer_cb, DEBUG_ALIGNMENT_CHART_FEED_PERIOD, nullptr);
+    } else {
+        lv_timer_resume(chart_feed_timer);
+    }
+    DA_LOGD("%s: feeding %d samples/s", obj.name.c_str(), obj.props_as<ChartProps>()->feed_rate);
+}
+
+// Charts themselves are deleted by clear_spawned_objects()
+void DebugAlignmentEnhanced::stop_chart_feeds() {
+    chart_feeds.clear();
+    if (chart_feed_timer) {
+        lv_timer_delete(chart_feed_timer);
+        chart_feed_timer = nullptr;
+    }
+}
+
+void DebugAlignmentEnhanced::feed_chart(SpawnedObject& obj, ChartFeed& feed, uint32_t now) {
+    const ChartProps* chart = obj.props_as<ChartProps>();
+    uint64_t owed = (uint64_t)chart->feed_rate * (uint32_t)(now - feed.last_tick) + feed.owed;
+    feed.last_tick = now;
+    feed.owed = (uint32_t)(owed % 1000);
+    uint64_t due = owed / 1000;
+    if (due == 0) return;
+
+    // After a stall only the newest chart_points samples would survive anyway
+    uint32_t points = (uint32_t)chart->chart_points;
+    if (due > points) {
+        feed.next_sample += due - points;
+        due = points;
+    }
+    int series = 0;
+    for (lv_chart_series_t* ser = lv_chart_get_series_next(obj.object, nullptr); ser;
+         ser = lv_chart_get_series_next(obj.object, ser), series++) {
+        if ((size_t)series < feed.envelopes.size()) {
+            // Finished columns go to the chart once; the open one is written after the
+            // batch, over its previous state if it was already shown
+            ChartFeed::SeriesEnvelope& envelope = feed.envelopes[series];
+            ColumnEnvelope finished;
+            for (uint64_t i = 0; i < due; i++) {
+                int32_t value = chart_sample(series, feed.next_sample + i, chart->y_min, chart->y_max);
+                if (envelope.decimator.push(feed.next_sample + i, value, finished)) {
+                    put_column(obj.object, ser, finished, envelope.shown);
+                    envelope.shown = false;
+                }
+            }
+            put_column(obj.object, ser, envelope.decimator.open(), envelope.shown);
+            envelope.shown = true;
+            continue;
+        }
+        for (uint64_t i = 0; i < due; i++) {
+            lv_chart_set_next_value(obj.object, ser, chart_sample(series, feed.next_sample + i, chart->y_min, chart->y_max));
+        }
+    }
+    feed.next_sample += due;
+    feed.window_points += (uint32_t)due * (uint32_t)series;
+}
+
+void DebugAlignmentEnhanced::chart_feed_timer_cb(lv_timer_t* timer) {
+    uint32_t now = lv_tick_get();
+    bool window_closed = false;
+    for (size_t i = 0; i < chart_feeds.size();) {
+        ChartFeed& feed = chart_feeds[i];
+        SpawnedObject* obj = spawned_objects.get(feed.handle);
+        const ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+        if (!chart || chart->feed_rate <= 0) {
+            // Deleted, or switched off: forget it (and its draw timing, if it still exists)
+            if (obj && obj->object) {
+                while (lv_obj_remove_event_cb(obj->object, chart_draw_timing_event)) continue;
+                lv_obj_remove_event_cb(obj->object, chart_size_changed_event);
+            }
+            chart_feeds[i] = chart_feeds.back();
+            chart_feeds.pop_back();
+            continue;
+        }
+        if (feed.resized) {
+            feed.resized = false;
+            apply_chart_props(*obj);
+        }
+        feed_chart(*obj, feed, now);
+
+        uint32_t window = now - feed.window_start;
+        if (window >= READOUT_WINDOW_MS) {
+            feed.points_per_sec = (uint32_t)((uint64_t)feed.window_points * 1000 / window);
+            feed.draw_us = feed.window_draws ? (uint32_t)(feed.window_draw_us / feed.window_draws) : 0;
+            feed.draw_permille = (uint32_t)(feed.window_draw_us / window);  // us per ms = permille
+            feed.window_start = now;
+            feed.window_points = 0;
+            feed.window_draw_us = 0;
+            feed.window_draws = 0;
+            window_closed = true;
+        }
+        i++;
+    }
+    // The readout only changes once per window, so it never adds a redraw per tick
+    if (window_closed) refresh_chart_readout();
+    if (chart_feeds.empty()) {
+        lv_timer_pause(timer);
+        refresh_chart_readout();
+    }
+}
+
+void DebugAlignmentEnhanced::chart_draw_timing_event(lv_event_t* e) {
+    lv_obj_t* target = lv_event_get_current_target_obj(e);
+    for (ChartFeed& feed : chart_feeds) {
+        if (feed.chart != target) continue;
+        uint64_t now = DEBUG_ALIGNMENT_TIME_US();
+        if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN_BEGIN) {
+            feed.draw_begin_us = now;
+        } else if (feed.draw_begin_us) {
+            feed.window_draw_us += now - feed.draw_begin_us;
+            feed.window_draws++;
+            feed.draw_begin_us = 0;
+        }
+        return;
+    }
+}
+
+void DebugAlignmentEnhanced::chart_readout_deleted_event(lv_event_t*) { chart_readout_label = nullptr; }
+
+void DebugAlignmentEnhanced::refresh_chart_readout() {
+    if (!chart_readout_label) return;
+    SpawnedObject* obj = active_object();
+    const ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    const ChartFeed* feed = find_chart_feed(obj->handle);
+    if (!feed || chart->feed_rate <= 0) {
+        lv_label_set_text_fmt(chart_readout_label, " Feed off  (%d points)", chart->chart_points);
+        return;
+    }
+    lv_label_set_text_fmt(chart_readout_label, " %d/s set, %u points/s  |  draw %u us, %u.%u%% of time%s",
+                          chart->feed_rate, (unsigned)feed->points_per_sec, (unsigned)feed->draw_us,
+                          (unsigned)(feed->draw_permille / 10), (unsigned)(feed->draw_permille % 10),
+                          feed->per_column ? "  |  min/max" : "");
+}
+
+// Chart controls. Edits go through apply_properties_to_object() so the heap new series
+// take is charged to the chart.
+void DebugAlignmentEnhanced::chart_toggle_type_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->chart_type = (chart->chart_type + 1) % 3;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_add_series_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart || chart->series_count >= CHART_MAX_SERIES) return;
+    chart->series_count++;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_remove_series_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart || chart->series_count <= 1) return;
+    chart->series_count--;
+    apply_properties_to_object(*obj);
+}
+
+// Steps of 10 up to 100 points, then doubling, so 100k is a handful of presses away
+void DebugAlignmentEnhanced::chart_point_count_plus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->chart_points = chart->chart_points < 100 ? chart->chart_points + 10 : chart->chart_points * 2;
+    apply_properties_to_object(*obj);
+    refresh_chart_readout();
+}
+
+void DebugAlignmentEnhanced::chart_point_count_minus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->chart_points = chart->chart_points > 100 ? chart->chart_points / 2 : chart->chart_points - 10;
+    apply_properties_to_object(*obj);
+    refresh_chart_readout();
+}
+
+void DebugAlignmentEnhanced::chart_y_min_plus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart || chart->y_min + 10 >= chart->y_max) return;
+    chart->y_min += 10;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_y_min_minus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->y_min -= 10;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_y_max_plus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->y_max += 10;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_y_max_minus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart || chart->y_max - 10 <= chart->y_min) return;
+    chart->y_max -= 10;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_div_lines_plus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->h_div_lines++;
+    chart->v_div_lines++;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_div_lines_minus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->h_div_lines = std::max(0, chart->h_div_lines - 1);
+    chart->v_div_lines = std::max(0, chart->v_div_lines - 1);
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_toggle_update_mode_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->update_mode = chart->update_mode == 1 ? 0 : 1;
+    apply_properties_to_object(*obj);
+}
+
+void DebugAlignmentEnhanced::chart_feed_rate_plus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    int i = 0;
+    while (i < FEED_RATE_COUNT - 1 && feed_rates[i] <= chart->feed_rate) i++;
+    chart->feed_rate = std::max(chart->feed_rate, feed_rates[i]);
+    apply_properties_to_object(*obj);
+    refresh_chart_readout();
+}
+
+void DebugAlignmentEnhanced::chart_feed_rate_minus_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    int i = FEED_RATE_COUNT - 1;
+    while (i > 0 && feed_rates[i] >= chart->feed_rate) i--;
+    chart->feed_rate = std::min(chart->feed_rate, feed_rates[i]);
+    apply_properties_to_object(*obj);
+    refresh_chart_readout();
+}
+
+void DebugAlignmentEnhanced::chart_toggle_decimation_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    ChartProps* chart = obj ? obj->props_as<ChartProps>() : nullptr;
+    if (!chart) return;
+    chart->decimate = chart->decimate ? 0 : 1;
+    apply_properties_to_object(*obj);
+    refresh_chart_readout();
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
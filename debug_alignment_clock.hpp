@@ -0,0 +1,23 @@
+/*
+File:   debug_alignment_clock.hpp
+Author: Will Jenkins
+Purpose: Microsecond timestamps for the overlay's timing readouts
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// lv_tick_get() only resolves milliseconds, too coarse to time a single redraw.
+// Define DEBUG_ALIGNMENT_TIME_US() to a target timer (esp_timer_get_time(), a
+// DWT cycle counter scaled to us, ...) where std::chrono is unavailable or slow.
+#ifndef DEBUG_ALIGNMENT_TIME_US
+#include <chrono>
+
+inline uint64_t debug_alignment_time_us() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#define DEBUG_ALIGNMENT_TIME_US() debug_alignment_time_us()
+#endif
@@ -0,0 +1,319 @@
+/*
+File:   debug_alignment_codegen.cpp
+Author: Will Jenkins
+Purpose: LVGL creation code generation for the spawned scene, regenerated per object
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+std::vector<std::string> DebugAlignmentEnhanced::codegen_fragments;
+
+namespace {
+
+// Reused between runs so regenerating keeps the capacity it already has
+std::string fragment_scratch;
+std::string codegen_output;
+
+void appendf(std::string& out, const char* fmt, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, fmt);
+    va_list retry;
+    va_copy(retry, args);
+    int n = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n >= (int)sizeof(line)) {
+        size_t start = out.size();
+        out.resize(start + n + 1);
+        vsnprintf(&out[start], n + 1, fmt, retry);
+        out.resize(start + n);
+    } else if (n > 0) {
+        out.append(line, n);
+    }
+    va_end(retry);
+}
+
+// create_<name> function for an object
+void function_name(const std::string& name, char* out) {
+    char id[EXPORT_IDENTIFIER_SIZE];
+    export_identifier(name.c_str(), id);
+    char* p = out + sprintf(out, "create_");
+    for (const char* c = id; *c; c++) *p++ = (char)tolower((unsigned char)*c);
+    *p = '\0';
+}
+
+// True if the file at path already holds exactly these bytes
+bool file_matches(const char* path, const std::string& bytes) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    char chunk[1024];
+    size_t offset = 0;
+    bool same = true;
+    size_t got;
+    while (same && (got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        same = offset + got <= bytes.size() && memcmp(chunk, bytes.data() + offset, got) == 0;
+        offset += got;
+    }
+    fclose(file);
+    return same && offset == bytes.size();
+}
+
+}  // namespace
+
+// One self-contained function per object reproducing what the overlay did to it:
+// create_widget_instance(), the transform as flush_transform() pushes it, the props
+// as apply_properties_to_object() applies them, and the Style tab overrides. Nothing
+// in it depends on other objects or list positions, so its bytes only change when
+// this object does.
+void DebugAlignmentEnhanced::generate_fragment(const SpawnedObject& obj, std::string& out) {
+    char name[EXPORT_IDENTIFIER_SIZE + 8];
+    function_name(obj.name, name);
+    appendf(out, "/* %s */\nstatic lv_obj_t* %s(lv_obj_t* parent)\n{\n", obj.name.c_str(), name);
+
+    switch (obj.type) {
+        case WidgetType::ARC:
+            out += "    lv_obj_t* obj = lv_arc_create(parent);\n";
+            break;
+        case WidgetType::PIE_CHART:
+            out += "    lv_obj_t* obj = lv_arc_create(parent);\n"
+                   "    lv_arc_set_range(obj, 0, 360);\n"
+                   "    lv_arc_set_value(obj, 90);\n"
+                   "    lv_arc_set_bg_angles(obj, 0, 360);\n";
+            break;
+        case WidgetType::BAR:
+            out += "    lv_obj_t* obj = lv_bar_create(parent);\n";
+            break;
+        case WidgetType::SLIDER:
+            out += "    lv_obj_t* obj = lv_slider_create(parent);\n";
+            break;
+        case WidgetType::BUTTON:
+            out += "    lv_obj_t* obj = lv_btn_create(parent);\n"
+                   "    lv_obj_t* label = lv_label_create(obj);\n"
+                   "    lv_label_set_text(label, \"Button\");\n"
+                   "    lv_obj_center(label);\n";
+            break;
+        case WidgetType::CANVAS: {
+            // A buffer of its own, sized like the pool sizes it (stride x height)
+            const CanvasProps* canvas = obj.props_as<CanvasProps>();
+            CanvasProps defaults;
+            if (!canvas) canvas = &defaults;
+            uint32_t width = (uint32_t)std::max(1, canvas->canvas_width);
+            uint32_t height = (uint32_t)std::max(1, canvas->canvas_height);
+            const char* format = CanvasBufferPool::format_name(canvas->color_format);
+            appendf(out, "    LV_ATTRIBUTE_MEM_ALIGN static uint8_t buf[%u];\n",
+                    (unsigned)CanvasBufferPool::buffer_size(width, height, CanvasBufferPool::format_at(canvas->color_format)));
+            out += "    lv_obj_t* obj = lv_canvas_create(parent);\n";
+            appendf(out, "    lv_canvas_set_buffer(obj, buf, %u, %u, LV_COLOR_FORMAT_%s);\n", (unsigned)width,
+                    (unsigned)height, format);
+            appendf(out, "    lv_canvas_fill_bg(obj, lv_color_hex(0x%06X), LV_OPA_COVER);\n",
+                    (unsigned)canvas->fill_color & 0xFFFFFFu);
+            // The pattern kernels are the overlay's own; the generated canvas gets the plain fill
+            TestPattern pattern = static_cast<TestPattern>(canvas->test_pattern);
+            if (canvas->test_drawing && pattern != TestPattern::SOLID && pattern < TestPattern::COUNT) {
+                appendf(out, "    // test pattern not generated (%s)\n", pattern_name(pattern));
+            }
+            break;
+        }
+        case WidgetType::CHART:
+            out += "    lv_obj_t* obj = lv_chart_create(parent);\n"
+                   "    lv_chart_add_series(obj, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);\n";
+            break;
+        case WidgetType::CHECKBOX:
+            out += "    lv_obj_t* obj = lv_checkbox_create(parent);\n"
+                   "    lv_checkbox_set_text(obj, \"Checkbox\");\n";
+            break;
+        case WidgetType::LED:
+            out += "    lv_obj_t* obj = lv_led_create(parent);\n"
+                   "    lv_led_set_color(obj, lv_palette_main(LV_PALETTE_RED));\n";
+            break;
+        case WidgetType::MESSAGE_BOX:
+            out += "    lv_obj_t* obj = lv_obj_create(parent);\n"
+                   "    lv_obj_set_style_bg_color(obj, lv_color_hex(0x444444), LV_PART_MAIN);\n"
+                   "    lv_obj_t* label = lv_label_create(obj);\n"
+                   "    lv_label_set_text(label, \"Message Box\");\n"
+                   "    lv_obj_center(label);\n";
+            break;
+        case WidgetType::SPIN_BOX:
+            out += "    lv_obj_t* obj = lv_spinbox_create(parent);\n"
+                   "    lv_spinbox_set_range(obj, 0, 100);\n"
+                   "    lv_spinbox_set_value(obj, 50);\n";
+            break;
+        case WidgetType::SPINNER:
+            out += "    lv_obj_t* obj = lv_spinner_create(parent);\n";
+            break;
+        case WidgetType::SWITCH:
+            out += "    lv_obj_t* obj = lv_switch_create(parent);\n";
+            break;
+        case WidgetType::TABLE:
+            out += "    lv_obj_t* obj = lv_table_create(parent);\n"
+                   "    lv_table_set_cell_value(obj, 0, 0, \"A\");\n"
+                   "    lv_table_set_cell_value(obj, 0, 1, \"B\");\n"
+                   "    lv_table_set_cell_value(obj, 1, 0, \"C\");\n"
+                   "    lv_table_set_cell_value(obj, 1, 1, \"D\");\n";
+            break;
+    }
+
+    appendf(out, "    lv_obj_set_pos(obj, %d, %d);\n", obj.transform.x_offset, obj.transform.y_offset);
+    appendf(out, "    lv_obj_set_size(obj, %d, %d);\n", obj.transform.width, obj.transform.height);
+    if (obj.type == WidgetType::ARC) {
+        appendf(out, "    lv_arc_set_rotation(obj, %d);\n", obj.transform.rotation);
+    } else if (obj.transform.rotation) {
+        appendf(out, "    lv_obj_set_style_transform_angle(obj, %d, LV_PART_MAIN);\n", obj.transform.rotation * 10);
+    }
+    if (obj.transform.pad) {
+        appendf(out, "    lv_obj_set_style_pad_all(obj, %d, LV_PART_MAIN);\n", obj.transform.pad);
+    }
+
+    if (const ArcProps* arc = obj.props_as<ArcProps>()) {
+        appendf(out,
+                "    lv_arc_set_bg_angles(obj, %d, %d);\n"
+                "    lv_arc_set_range(obj, %d, %d);\n"
+                "    lv_arc_set_value(obj, %d);\n"
+                "    lv_obj_set_style_arc_width(obj, %d, LV_PART_INDICATOR);\n"
+                "    lv_obj_set_style_arc_width(obj, %d, LV_PART_MAIN);\n"
+                "    lv_obj_set_style_arc_opa(obj, %s, LV_PART_MAIN);\n"
+                "    lv_obj_set_style_arc_rounded(obj, %s, LV_PART_INDICATOR);\n"
+                "    lv_obj_set_style_pad_all(obj, %d, LV_PART_MAIN);\n",
+                arc->start_angle, arc->end_angle, arc->range_min, arc->range_max, arc->value, arc->arc_width,
+                arc->track_width, arc->track_visible ? "LV_OPA_COVER" : "LV_OPA_TRANSP",
+                arc->rounded_caps ? "true" : "false", arc->pad);
+    } else if (const BarProps* bar = obj.props_as<BarProps>()) {
+        if (obj.type == WidgetType::BAR) {
+            appendf(out,
+                    "    lv_bar_set_mode(obj, %s);\n"
+                    "    lv_bar_set_range(obj, %d, %d);\n"
+                    "    lv_bar_set_value(obj, %d, LV_ANIM_OFF);\n",
+                    bar->bar_mode == 0 ? "LV_BAR_MODE_NORMAL" : "LV_BAR_MODE_RANGE", bar->min_value,
+                    bar->max_value, bar->current_value);
+        } else {
+            appendf(out,
+                    "    lv_slider_set_range(obj, %d, %d);\n"
+                    "    lv_slider_set_value(obj, %d, LV_ANIM_OFF);\n",
+                    bar->min_value, bar->max_value, bar->current_value);
+        }
+    } else if (const ChartProps* chart = obj.props_as<ChartProps>()) {
+        static const char* const types[] = {"LV_CHART_TYPE_LINE", "LV_CHART_TYPE_BAR", "LV_CHART_TYPE_SCATTER"};
+        static const char* const palette[] = {"LV_PALETTE_RED",    "LV_PALETTE_BLUE",   "LV_PALETTE_GREEN",
+                                              "LV_PALETTE_ORANGE", "LV_PALETTE_PURPLE", "LV_PALETTE_TEAL"};
+        appendf(out,
+                "    lv_chart_set_type(obj, %s);\n"
+                "    lv_chart_set_point_count(obj, %d);\n"
+                "    lv_chart_set_range(obj, LV_CHART_AXIS_PRIMARY_Y, %d, %d);\n"
+                "    lv_chart_set_div_line_count(obj, %d, %d);\n"
+                "    lv_chart_set_update_mode(obj, %s);\n",
+                types[chart->chart_type >= 1 && chart->chart_type <= 2 ? chart->chart_type : 0], chart->chart_points,
+                chart->y_min, chart->y_max, chart->h_div_lines, chart->v_div_lines,
+                chart->update_mode == 1 ? "LV_CHART_UPDATE_MODE_SHIFT" : "LV_CHART_UPDATE_MODE_CIRCULAR");
+        // The first series comes with the chart
+        for (int i = 1; i < chart->series_count && i < (int)(sizeof(palette) / sizeof(palette[0])); i++) {
+            appendf(out, "    lv_chart_add_series(obj, lv_palette_main(%s), LV_CHART_AXIS_PRIMARY_Y);\n", palette[i]);
+        }
+    } else if (const ToggleProps* toggle = obj.props_as<ToggleProps>()) {
+        if (toggle->disabled) out += "    lv_obj_add_state(obj, LV_STATE_DISABLED);\n";
+        if (toggle->state) {
+            switch (obj.type) {
+                case WidgetType::SWITCH:
+                case WidgetType::CHECKBOX: out += "    lv_obj_add_state(obj, LV_STATE_CHECKED);\n"; break;
+                case WidgetType::LED: out += "    lv_led_on(obj);\n"; break;
+                default: out += "    lv_obj_add_state(obj, LV_STATE_PRESSED);\n"; break;
+            }
+        } else if (obj.type == WidgetType::LED) {
+            out += "    lv_led_off(obj);\n";
+        }
+    } else if (!obj.props_as<CanvasProps>()) {
+        // The overlay never applies these props to its widget, so the widget as created
+        // above is what it shows
+        appendf(out, "    // props not generated for %s\n", get_widget_type_name(obj.type).c_str());
+    }
+
+    // Style tab overrides are the only local values of these properties
+    if (obj.object) {
+        lv_style_value_t value;
+        if (lv_obj_get_local_style_prop(obj.object, LV_STYLE_BORDER_WIDTH, &value, LV_PART_MAIN) == LV_RESULT_OK) {
+            appendf(out, "    lv_obj_set_style_border_width(obj, %d, LV_PART_MAIN);\n", (int)value.num);
+        }
+        if (lv_obj_get_local_style_prop(obj.object, LV_STYLE_RADIUS, &value, LV_PART_MAIN) == LV_RESULT_OK) {
+            appendf(out, "    lv_obj_set_style_radius(obj, %d, LV_PART_MAIN);\n", (int)value.num);
+        }
+        if (lv_obj_get_local_style_prop(obj.object, LV_STYLE_OPA, &value, LV_PART_MAIN) == LV_RESULT_OK) {
+            appendf(out, "    lv_obj_set_style_opa(obj, %d, LV_PART_MAIN);\n", (int)value.num);
+        }
+        if (lv_obj_has_flag(obj.object, LV_OBJ_FLAG_HIDDEN)) {
+            out += "    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);\n";
+        }
+    }
+    out += "    return obj;\n}\n\n";
+}
+
+bool DebugAlignmentEnhanced::generate_code(const char* path) {
+    int regenerated = 0;
+    for (auto& obj : spawned_objects) {
+        if (obj.handle.slot >= codegen_fragments.size()) {
+            codegen_fragments.resize(obj.handle.slot + 1);
+        }
+        std::string& fragment = codegen_fragments[obj.handle.slot];
+        if (!obj.codegen_dirty && !fragment.empty()) continue;
+        obj.codegen_dirty = 0;
+        fragment_scratch.clear();
+        generate_fragment(obj, fragment_scratch);
+        if (fragment_scratch != fragment) {
+            fragment.swap(fragment_scratch);
+            regenerated++;
+        }
+    }
+
+    // Functions in spawn order, so deleting or restacking one object never moves
+    // another's bytes; the calls that create them follow the stacking order
+    std::vector<const SpawnedObject*> order;
+    order.reserve(spawned_objects.size());
+    for (const auto& obj : spawned_objects) {
+        order.push_back(&obj);
+    }
+    std::sort(order.begin(), order.end(),
+              [](const SpawnedObject* a, const SpawnedObject* b) { return a->serial < b->serial; });
+
+    codegen_output.clear();
+    codegen_output += "/*\n"
+                      " * Generated by the debug alignment overlay (generate_code). Do not edit;\n"
+                      " * adjust the layout in the overlay and regenerate.\n"
+                      " */\n\n"
+                      "#include \"lvgl/lvgl.h\"\n\n";
+    for (const SpawnedObject* obj : order) {
+        codegen_output += codegen_fragments[obj->handle.slot];
+    }
+    std::stable_sort(order.begin(), order.end(), [](const SpawnedObject* a, const SpawnedObject* b) {
+        return read_field(*a, FIELD_Z_INDEX) < read_field(*b, FIELD_Z_INDEX);
+    });
+    codegen_output += "void debug_alignment_create_scene(lv_obj_t* parent)\n{\n";
+    for (const SpawnedObject* obj : order) {
+        char name[EXPORT_IDENTIFIER_SIZE + 8];
+        function_name(obj->name, name);
+        appendf(codegen_output, "    %s(parent);\n", name);
+    }
+    codegen_output += "}\n";
+
+    // Leave the file (and its timestamp) alone when nothing in it changed
+    if (file_matches(path, codegen_output)) {
+        DA_LOGD("Generated code in %s is up to date (%d fragments rebuilt)", path, regenerated);
+        return true;
+    }
+    FILE* file = fopen(path, "wb");
+    bool ok = file && fwrite(codegen_output.data(), 1, codegen_output.size(), file) == codegen_output.size();
+    if (file && fclose(file) != 0) ok = false;
+    if (!ok) {
+        DA_LOGE("Could not write generated code to %s", path);
+        return false;
+    }
+    DA_LOGI("Generated %d objects into %s (%d fragments rebuilt)", (int)order.size(), path, regenerated);
+    return true;
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
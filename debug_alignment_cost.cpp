@@ -0,0 +1,116 @@
+/*
+File:   debug_alignment_cost.cpp
+Author: Will Jenkins
+Purpose: Per-object render cost ranking, shown in the spawn menu and written with the export
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_clock.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+#include <cstdio>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// Redraws per object and state; the fastest of them is kept, which drops the ones a
+// cache miss or an interrupt made slower
+#ifndef DEBUG_ALIGNMENT_COST_SAMPLES
+#define DEBUG_ALIGNMENT_COST_SAMPLES 8
+#endif
+
+std::vector<DebugAlignmentEnhanced::RenderCost> DebugAlignmentEnhanced::render_costs;
+lv_obj_t* DebugAlignmentEnhanced::render_cost_label = nullptr;
+
+// Hiding or showing an object invalidates its area (transformed and with its extra draw
+// size), so toggling the flag twice queues exactly the area a shown redraw covers. The
+// refresh is synchronous: nothing else runs between the invalidation and the timing.
+uint32_t DebugAlignmentEnhanced::time_object_redraw(lv_display_t* display, lv_obj_t* object, bool hidden) {
+    uint32_t fastest = UINT32_MAX;
+    for (int i = 0; i < DEBUG_ALIGNMENT_COST_SAMPLES; i++) {
+        if (hidden) {
+            lv_obj_clear_flag(object, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_add_flag(object, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_invalidate(object);
+        }
+        uint64_t begin = DEBUG_ALIGNMENT_TIME_US();
+        lv_refr_now(display);
+        fastest = std::min(fastest, (uint32_t)(DEBUG_ALIGNMENT_TIME_US() - begin));
+    }
+    return fastest;
+}
+
+// Objects the user hid cost nothing and are left out. Flushing goes into both timings
+// for the same area, so it cancels out of the difference.
+void DebugAlignmentEnhanced::measure_render_costs() {
+    render_costs.clear();
+    lv_display_t* display = parent_screen ? lv_obj_get_display(parent_screen) : nullptr;
+    if (!display) return;
+
+    // Edits still waiting for the transform flush, then whatever is already invalid
+    for (auto& obj : spawned_objects) {
+        if (obj.transform_dirty) flush_transform(obj);
+    }
+    lv_refr_now(display);
+
+    uint64_t begin = DEBUG_ALIGNMENT_TIME_US();
+    for (const auto& obj : spawned_objects) {
+        if (!obj.object || lv_obj_has_flag(obj.object, LV_OBJ_FLAG_HIDDEN)) continue;
+        RenderCost cost;
+        cost.handle = obj.handle;
+        cost.shown_us = time_object_redraw(display, obj.object, false);
+        cost.hidden_us = time_object_redraw(display, obj.object, true);
+        lv_obj_clear_flag(obj.object, LV_OBJ_FLAG_HIDDEN);
+        render_costs.push_back(cost);
+    }
+    lv_refr_now(display);
+    std::stable_sort(render_costs.begin(), render_costs.end(),
+                     [](const RenderCost& a, const RenderCost& b) { return a.cost_us() > b.cost_us(); });
+
+    DA_LOGI("Measured render cost of %u objects in %u ms", (unsigned)render_costs.size(),
+            (unsigned)((DEBUG_ALIGNMENT_TIME_US() - begin) / 1000));
+    if (!render_costs.empty()) {
+        const SpawnedObject* top = spawned_objects.get(render_costs.front().handle);
+        DA_LOGI("Costliest: %s at %u us", top->name.c_str(), (unsigned)render_costs.front().cost_us());
+    }
+    refresh_render_cost_table();
+}
+
+void DebugAlignmentEnhanced::render_cost_event(lv_event_t*) { measure_render_costs(); }
+
+// One line per object still alive; deleted objects drop out until the next measurement
+void DebugAlignmentEnhanced::refresh_render_cost_table() {
+    if (!render_cost_label) return;
+    std::string text;
+    char line[128];
+    int rank = 0;
+    for (const RenderCost& cost : render_costs) {
+        const SpawnedObject* obj = spawned_objects.get(cost.handle);
+        if (!obj) continue;
+        snprintf(line, sizeof(line), "%2d. %-16s %6u us   (shown %u, hidden %u)\n", ++rank, obj->name.c_str(),
+                 (unsigned)cost.cost_us(), (unsigned)cost.shown_us, (unsigned)cost.hidden_us);
+        text += line;
+    }
+    if (text.empty()) {
+        text = "Not measured yet. Measure redraws each visible object shown and hidden.";
+    } else {
+        text.pop_back();
+    }
+    lv_label_set_text(render_cost_label, text.c_str());
+}
+
+// Same ranking as the panel, as comments ahead of the #defines
+void DebugAlignmentEnhanced::export_render_costs(ExportStream& out) {
+    if (render_costs.empty()) return;
+    out.print("// Render cost, costliest first (us per redraw of the object's area, shown minus hidden)\n");
+    int rank = 0;
+    for (const RenderCost& cost : render_costs) {
+        const SpawnedObject* obj = spawned_objects.get(cost.handle);
+        if (!obj) continue;
+        out.print("//   %2d. %-16s %6u us  (shown %u, hidden %u)\n", ++rank, obj->name.c_str(), (unsigned)cost.cost_us(),
+                  (unsigned)cost.shown_us, (unsigned)cost.hidden_us);
+    }
+    out.write("\n", 1);
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
@@ -0,0 +1,23 @@
+/*
+File:   debug_alignment_decimate.cpp
+Author: Will Jenkins
+Purpose: Min/max envelope decimation of a sample stream, one column per display pixel
+*/
+
+#include "debug_alignment_decimate.hpp"
+
+uint32_t MinMaxDecimator::samples_per_column(uint32_t points, uint32_t columns) {
+    if (columns == 0 || points <= columns) return 1;
+    return (points + columns - 1) / columns;
+}
+
+uint32_t MinMaxDecimator::column_count(uint32_t points, uint32_t per_column) {
+    if (per_column == 0) return points;
+    return (points + per_column - 1) / per_column;
+}
+
+void MinMaxDecimator::reset(uint32_t per_column) {
+    per_column_ = per_column ? per_column : 1;
+    column_end_ = 0;
+    open_ = ColumnEnvelope();
+}
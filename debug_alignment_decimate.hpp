@@ -0,0 +1,68 @@
+/*
+File:   debug_alignment_decimate.hpp
+Author: Will Jenkins
+Purpose: Min/max envelope decimation of a sample stream, one column per display pixel
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Lowest and highest sample of one column, kept in the order they occurred so a line
+// through consecutive columns still follows the signal
+struct ColumnEnvelope {
+    int32_t min = 0;
+    int32_t max = 0;
+    bool min_first = true;
+
+    int32_t first() const { return min_first ? min : max; }
+    int32_t second() const { return min_first ? max : min; }
+};
+
+// Folds a stream of samples into columns of samples_per_column() consecutive samples.
+// Columns are anchored to the absolute sample index (column k holds samples
+// [k * n, (k + 1) * n)), not to the window the chart shows, so as the window scrolls
+// only the newest column changes and finished columns never need recomputing: each
+// sample costs O(1) whatever the window size.
+class MinMaxDecimator {
+public:
+    // Samples per column to fit `points` samples into `columns` columns, at least 1
+    static uint32_t samples_per_column(uint32_t points, uint32_t columns);
+    // Columns needed to show `points` samples at `per_column` samples each
+    static uint32_t column_count(uint32_t points, uint32_t per_column);
+
+    void reset(uint32_t per_column);
+    uint32_t per_column() const { return per_column_; }
+    bool empty() const { return column_end_ == 0; }
+
+    // Adds the sample at absolute `index`; indices must increase but may skip. Returns
+    // true if the sample started a new column, in which case the column it finished
+    // is copied to `finished` (on the very first sample nothing was finished and the
+    // result is false).
+    bool push(uint64_t index, int32_t value, ColumnEnvelope& finished) {
+        if (index < column_end_) {
+            if (value < open_.min) {
+                open_.min = value;
+                open_.min_first = false;
+            } else if (value > open_.max) {
+                open_.max = value;
+                open_.min_first = true;
+            }
+            return false;
+        }
+        bool had_column = !empty();
+        finished = open_;
+        column_end_ = (index / per_column_ + 1) * per_column_;
+        open_.min = open_.max = value;
+        open_.min_first = true;
+        return had_column;
+    }
+
+    // The column still taking samples; valid once a sample was pushed
+    const ColumnEnvelope& open() const { return open_; }
+
+private:
+    uint32_t per_column_ = 1;
+    uint64_t column_end_ = 0;  // First index past the open column, 0 before any sample
+    ColumnEnvelope open_;
+};
@@ -5,6 +5,8 @@ Purpose: Enhanced debug alignment overlay implementation with widget spawning
 */
 
 #include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+#include "debug_alignment_clock.hpp"
 #include <cstdio>
 #include <algorithm>
 
@@ -13,8 +15,15 @@ lv_obj_t* DebugAlignmentEnhanced::debug_panel = nullptr;
 lv_obj_t* DebugAlignmentEnhanced::toggle_button = nullptr;
 bool DebugAlignmentEnhanced::panel_visible = false;
 DebugAlignmentEnhanced::UIState DebugAlignmentEnhanced::current_state = UIState::SPAWN_MENU;
-std::vector<DebugAlignmentEnhanced::SpawnedObject> DebugAlignmentEnhanced::spawned_objects;
-int DebugAlignmentEnhanced::active_object_index = -1;
+SlotMap<DebugAlignmentEnhanced::SpawnedObject> DebugAlignmentEnhanced::spawned_objects;
+DebugAlignmentEnhanced::ObjectHandle DebugAlignmentEnhanced::active_handle;
+uint32_t DebugAlignmentEnhanced::spawn_serial = 0;
+SpatialGrid DebugAlignmentEnhanced::spatial_index;
+EdgeIndex DebugAlignmentEnhanced::edge_index;
+bool DebugAlignmentEnhanced::guide_snap_enabled = true;
+DebugAlignmentEnhanced::GuideLine DebugAlignmentEnhanced::guides[2];
+UndoJournal DebugAlignmentEnhanced::journal;
+CanvasBufferPool DebugAlignmentEnhanced::canvas_pool;
 lv_obj_t* DebugAlignmentEnhanced::parent_screen = nullptr;
 lv_obj_t* DebugAlignmentEnhanced::content_area = nullptr;
 lv_obj_t* DebugAlignmentEnhanced::object_list_area = nullptr;
@@ -23,65 +32,65 @@ bool DebugAlignmentEnhanced::grid_snap_enabled = false;
 int DebugAlignmentEnhanced::grid_size = 10;
 lv_obj_t* DebugAlignmentEnhanced::widget_controls_parent = nullptr;
 lv_obj_t* DebugAlignmentEnhanced::grid_label_ptr = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::grid_toggle_label_ptr = nullptr;
+DebugAlignmentEnhanced::ControlPanel DebugAlignmentEnhanced::control_panels[DebugAlignmentEnhanced::WIDGET_TYPE_COUNT];
+lv_obj_t* DebugAlignmentEnhanced::spawn_menu_root = nullptr;
+DebugAlignmentEnhanced::ObjectChip DebugAlignmentEnhanced::object_chips[DebugAlignmentEnhanced::OBJECT_CHIP_POOL];
+lv_obj_t* DebugAlignmentEnhanced::object_strip = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::object_strip_spacer = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::object_list_empty_label = nullptr;
+lv_timer_t* DebugAlignmentEnhanced::transform_flush_timer = nullptr;
 
 void DebugAlignmentEnhanced::init(lv_obj_t* screen) {
 #if ENABLE_DEBUG_ALIGNMENT
     cleanup(); // Clean up any existing instances
+    DebugAlignmentLog::start();
     parent_screen = screen;
+    spatial_index.reset(lv_obj_get_width(screen), lv_obj_get_height(screen));
+    // Alignment guides are painted over the screen's children in a single pass
+    lv_obj_add_event_cb(screen, guides_draw_event, LV_EVENT_DRAW_POST, nullptr);
+    start_trace_hooks();
+    init_styles();
     
-    // Create modern toggle button with sleek design
+    // Create modern toggle button with sleek design (dark blue-gray to bright blue)
     toggle_button = lv_btn_create(screen);
     lv_obj_set_size(toggle_button, 120, 60);
     lv_obj_align(toggle_button, LV_ALIGN_TOP_RIGHT, -15, 15);
-    lv_obj_add_event_cb(toggle_button, toggle_panel_event, LV_EVENT_CLICKED, nullptr);
-    
-    // Modern dark theme with blue accent
-    lv_obj_set_style_bg_color(toggle_button, lv_color_hex(0x2C3E50), LV_PART_MAIN);  // Dark blue-gray
-    lv_obj_set_style_bg_grad_color(toggle_button, lv_color_hex(0x3498DB), LV_PART_MAIN);  // Bright blue
-    lv_obj_set_style_bg_grad_dir(toggle_button, LV_GRAD_DIR_VER, LV_PART_MAIN);
-    lv_obj_set_style_radius(toggle_button, 20, LV_PART_MAIN);
-    lv_obj_set_style_border_color(toggle_button, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(toggle_button, 2, LV_PART_MAIN);
-    lv_obj_set_style_shadow_color(toggle_button, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_shadow_width(toggle_button, 8, LV_PART_MAIN);
-    lv_obj_set_style_shadow_opa(toggle_button, LV_OPA_40, LV_PART_MAIN);
-    
-    lv_obj_t* toggle_label = lv_label_create(toggle_button);
-    lv_label_set_text(toggle_label, " DEBUG");
+    add_traced_event_cb(toggle_button, toggle_panel_event, LV_EVENT_CLICKED, "Toggle panel");
+    apply_style(toggle_button, PanelStyle::TOGGLE_BUTTON);
+    
+    lv_obj_t* toggle_label = create_styled_label(toggle_button, " DEBUG", PanelStyle::TEXT_BUTTON_LARGE);
     lv_obj_center(toggle_label);
-    lv_obj_set_style_text_color(toggle_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(toggle_label, &lv_font_montserrat_20, LV_PART_MAIN);
     
     // Bring the button to the front to ensure it's visible
     lv_obj_move_foreground(toggle_button);
     
+    // Coalesces transform edits into one push per frame; paused while nothing is pending
+    transform_flush_timer = lv_timer_create(flush_transforms_timer_cb, 0, nullptr);
+    lv_timer_pause(transform_flush_timer);
+    
+    // The panel itself is built on the first toggle(); until then only the button exists
+    current_state = UIState::SPAWN_MENU;
+    
+    DA_LOGI("🌸 Cherry Blossom Debug Alignment initialized! Look for the pink button in top-right! 🌸");
+    DA_LOGI("Interface size: 900x750, Modern glassmorphism design");
+}
+
+void DebugAlignmentEnhanced::build_debug_panel() {
     // Create sleek main debug panel with modern glassmorphism design
-    debug_panel = lv_obj_create(screen);
+    debug_panel = lv_obj_create(parent_screen);
     lv_obj_set_size(debug_panel, 900, 750);  // Wider and better proportioned
     lv_obj_align(debug_panel, LV_ALIGN_CENTER, 0, 0);  // Center it for better UX
     
     // Glassmorphism effect - semi-transparent with blur-like appearance
-    lv_obj_set_style_bg_color(debug_panel, lv_color_hex(0x1E1E1E), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(debug_panel, LV_OPA_40, LV_PART_MAIN);  // Semi-transparent
-    lv_obj_set_style_border_color(debug_panel, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(debug_panel, 3, LV_PART_MAIN);
-    lv_obj_set_style_radius(debug_panel, 25, LV_PART_MAIN);
-    lv_obj_set_style_shadow_color(debug_panel, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_shadow_width(debug_panel, 15, LV_PART_MAIN);
-    lv_obj_set_style_shadow_opa(debug_panel, LV_OPA_60, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(debug_panel, 20, LV_PART_MAIN);
+    apply_style(debug_panel, PanelStyle::PANEL);
     lv_obj_add_flag(debug_panel, LV_OBJ_FLAG_HIDDEN);
     
     // Create modern header area with title and object list
     object_list_area = lv_obj_create(debug_panel);
     lv_obj_set_size(object_list_area, LV_PCT(100), 90);
     lv_obj_align(object_list_area, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(object_list_area, lv_color_hex(0x2C3E50), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(object_list_area, LV_OPA_50, LV_PART_MAIN);
-    lv_obj_set_style_radius(object_list_area, 15, LV_PART_MAIN);
-    lv_obj_set_style_border_color(object_list_area, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(object_list_area, 2, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(object_list_area, 15, LV_PART_MAIN);
+    apply_style(object_list_area, PanelStyle::LIST_AREA);
     
     // Create main content area with modern card design
     content_area = lv_obj_create(debug_panel);
@@ -89,49 +98,59 @@ void DebugAlignmentEnhanced::init(lv_obj_t* screen) {
     lv_obj_align(content_area, LV_ALIGN_TOP_MID, 0, 100);
     
     // Modern card styling
-    lv_obj_set_style_bg_color(content_area, lv_color_hex(0x34495E), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(content_area, LV_OPA_40, LV_PART_MAIN);
-    lv_obj_set_style_radius(content_area, 15, LV_PART_MAIN);
-    lv_obj_set_style_border_color(content_area, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(content_area, 2, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(content_area, 20, LV_PART_MAIN);
+    apply_style(content_area, PanelStyle::CONTENT_AREA);
     
     // Enable smooth scrolling
     lv_obj_set_scroll_dir(content_area, LV_DIR_VER);
     lv_obj_set_scrollbar_mode(content_area, LV_SCROLLBAR_MODE_AUTO);
-    lv_obj_set_style_pad_right(content_area, 20, LV_PART_MAIN);
     
-    // Initialize with spawn menu
-    current_state = UIState::SPAWN_MENU;
+    // Show whichever view is current (the spawn menu unless objects were already selected)
     create_object_list();
-    create_spawn_menu();
+    if (current_state == UIState::OBJECT_CONTROLS) {
+        create_object_controls();
+    } else {
+        create_spawn_menu();
+    }
     
-    printf("\n🌸 [ENHANCED DEBUG] Cherry Blossom Debug Alignment initialized! Look for the pink button in top-right! 🌸\n");
-    printf("[DEBUG TOOLS] Interface size: 900x750, Modern glassmorphism design\n\n");
+    DA_LOGD("Debug panel built on first open");
 }
 
 void DebugAlignmentEnhanced::toggle() {
-    if (!debug_panel) return;
+    if (!toggle_button) return;
     
     if (panel_visible) {
         lv_obj_add_flag(debug_panel, LV_OBJ_FLAG_HIDDEN);
         panel_visible = false;
+        stop_perf_hooks();
     } else {
+        if (!debug_panel) {
+            build_debug_panel();
+        }
         lv_obj_clear_flag(debug_panel, LV_OBJ_FLAG_HIDDEN);
         panel_visible = true;
         update_object_list();
+        start_perf_hooks();
     }
 }
 
 void DebugAlignmentEnhanced::cleanup() {
-    // Delete all spawned objects
-    for (auto& obj : spawned_objects) {
-        if (obj.object) {
-            lv_obj_delete(obj.object);
-        }
+    if (transform_flush_timer) {
+        lv_timer_delete(transform_flush_timer);
+        transform_flush_timer = nullptr;
     }
-    spawned_objects.clear();
-    active_object_index = -1;
+    
+    clear_spawned_objects();
+    canvas_pool.clear();
+    stop_chart_feeds();
+    stop_perf_hooks();
+    set_redraw_heatmap(false);
+    stop_trace_hooks();  // Records are kept for the next screen's session
+    guides[EdgeIndex::AXIS_X] = GuideLine();
+    guides[EdgeIndex::AXIS_Y] = GuideLine();
+    if (parent_screen && lv_obj_is_valid(parent_screen)) {
+        lv_obj_remove_event_cb(parent_screen, guides_draw_event);
+    }
+    parent_screen = nullptr;
     
     if (debug_panel) {
         lv_obj_delete(debug_panel);
@@ -141,42 +160,87 @@ void DebugAlignmentEnhanced::cleanup() {
         lv_obj_delete(toggle_button);
         toggle_button = nullptr;
     }
+    // Nothing references the shared styles any more
+    reset_styles();
+    
+    // Retained panels were children of debug_panel and are gone with it
+    for (auto& panel : control_panels) {
+        panel = ControlPanel();
+    }
+    spawn_menu_root = nullptr;
+    for (auto& slot : object_chips) {
+        slot = ObjectChip();
+    }
+    object_strip = nullptr;
+    object_strip_spacer = nullptr;
+    object_list_empty_label = nullptr;
+    perf_strip = nullptr;
+    perf_label = nullptr;
+    heatmap_button_label = nullptr;
+    render_cost_label = nullptr;
+    memory_label = nullptr;
+    trace_label = nullptr;
+    widget_controls_parent = nullptr;
+    grid_label_ptr = nullptr;
+    grid_toggle_label_ptr = nullptr;
     
     content_area = nullptr;
     object_list_area = nullptr;
     controls_area = nullptr;
     panel_visible = false;
     current_state = UIState::SPAWN_MENU;
+    
+    // Write out whatever is still queued before the drain timer goes away
+    DebugAlignmentLog::stop();
+}
+
+// Transparent full-width container under content_area; one per retained view
+lv_obj_t* DebugAlignmentEnhanced::create_content_root() {
+    lv_obj_t* root = lv_obj_create(content_area);
+    lv_obj_set_size(root, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_align(root, LV_ALIGN_TOP_MID, 0, 0);
+    apply_style(root, PanelStyle::TRANSPARENT);
+    lv_obj_clear_flag(root, LV_OBJ_FLAG_SCROLLABLE);  // content_area does the scrolling
+    return root;
+}
+
+// Show one retained view and hide the others instead of rebuilding the content area
+void DebugAlignmentEnhanced::show_content_root(lv_obj_t* root) {
+    if (!content_area) return;
+    uint32_t count = lv_obj_get_child_count(content_area);
+    for (uint32_t i = 0; i < count; i++) {
+        lv_obj_t* child = lv_obj_get_child(content_area, i);
+        if (child == root) {
+            lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
 }
 
 void DebugAlignmentEnhanced::create_spawn_menu() {
-    clear_content_area();
+    if (!content_area) return;  // Panel not built yet; built on first open
+    if (spawn_menu_root) {
+        show_content_root(spawn_menu_root);
+        refresh_render_cost_table();
+        refresh_memory_report();
+        refresh_trace_report();
+        return;
+    }
+    spawn_menu_root = create_content_root();
+    show_content_root(spawn_menu_root);
     
     // Modern title with better typography
-    lv_obj_t* title = lv_label_create(content_area);
-    lv_label_set_text(title, "Widget Toolkit");
+    lv_obj_t* title = create_styled_label(spawn_menu_root, "Widget Toolkit", PanelStyle::TEXT_TITLE);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
-    lv_obj_set_style_text_color(title, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_32, LV_PART_MAIN);
     
     // Subtitle
-    lv_obj_t* subtitle = lv_label_create(content_area);
-    lv_label_set_text(subtitle, "Select a widget to create and customize");
+    lv_obj_t* subtitle = create_styled_label(spawn_menu_root, "Select a widget to create and customize", PanelStyle::TEXT_SUBTITLE);
     lv_obj_align(subtitle, LV_ALIGN_TOP_MID, 0, 50);
-    lv_obj_set_style_text_color(subtitle, lv_color_hex(0xBDC3C7), LV_PART_MAIN);
-    lv_obj_set_style_text_font(subtitle, &lv_font_montserrat_20, LV_PART_MAIN);
     
-    // Create a grid container for widget cards
-    lv_obj_t* grid_container = lv_obj_create(content_area);
-    lv_obj_set_size(grid_container, LV_PCT(100), LV_SIZE_CONTENT);
+    // Create a flex grid container for widget cards (cards get a wider gap than controls)
+    lv_obj_t* grid_container = create_control_grid(spawn_menu_root);
     lv_obj_align(grid_container, LV_ALIGN_TOP_MID, 0, 90);
-    lv_obj_set_style_bg_opa(grid_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(grid_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(grid_container, 10, LV_PART_MAIN);
-    
-    // Set up flex layout for responsive grid
-    lv_obj_set_flex_flow(grid_container, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(grid_container, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
     lv_obj_set_style_pad_row(grid_container, 15, LV_PART_MAIN);
     lv_obj_set_style_pad_column(grid_container, 15, LV_PART_MAIN);
     
@@ -211,114 +275,186 @@ void DebugAlignmentEnhanced::create_spawn_menu() {
         lv_obj_set_size(card, 180, 120);  // Compact card size
         
         // Modern card styling with gradient
-        lv_obj_set_style_bg_color(card, lv_color_hex(widgets[i].color), LV_PART_MAIN);
-        lv_obj_set_style_bg_grad_color(card, lv_color_hex(widgets[i].color & 0x7F7F7F), LV_PART_MAIN);
-        lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, LV_PART_MAIN);
-        lv_obj_set_style_radius(card, 15, LV_PART_MAIN);
-        lv_obj_set_style_border_color(card, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-        lv_obj_set_style_border_width(card, 2, LV_PART_MAIN);
-        lv_obj_set_style_border_opa(card, LV_OPA_30, LV_PART_MAIN);
-        lv_obj_set_style_shadow_color(card, lv_color_hex(0x000000), LV_PART_MAIN);
-        lv_obj_set_style_shadow_width(card, 10, LV_PART_MAIN);
-        lv_obj_set_style_shadow_opa(card, LV_OPA_30, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(card, 15, LV_PART_MAIN);
+        apply_style(card, PanelStyle::CARD);
+        apply_color_style(card, widgets[i].color);
         
         // Hover effect
-        lv_obj_set_style_transform_zoom(card, 105, LV_STATE_PRESSED);
-        lv_obj_set_style_shadow_width(card, 15, LV_STATE_PRESSED);
+        apply_style(card, PanelStyle::CARD_PRESSED, LV_STATE_PRESSED);
         
         // Add click event
-        lv_obj_add_event_cb(card, widgets[i].callback, LV_EVENT_CLICKED, nullptr);
+        char trace_name[32];
+        snprintf(trace_name, sizeof(trace_name), "Spawn %s", widgets[i].name);
+        add_traced_event_cb(card, widgets[i].callback, LV_EVENT_CLICKED, trace_name);
         lv_obj_add_flag(card, LV_OBJ_FLAG_CLICKABLE);
         
         // Name (centered since we removed the icon)
-        lv_obj_t* name = lv_label_create(card);
-        lv_label_set_text(name, widgets[i].name);
+        lv_obj_t* name = create_styled_label(card, widgets[i].name, PanelStyle::TEXT_BUTTON_LARGE);
         lv_obj_align(name, LV_ALIGN_CENTER, 0, -10);
-        lv_obj_set_style_text_font(name, &lv_font_montserrat_20, LV_PART_MAIN);
-        lv_obj_set_style_text_color(name, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
         
         // Description
-        lv_obj_t* desc = lv_label_create(card);
-        lv_label_set_text(desc, widgets[i].description);
+        lv_obj_t* desc = create_styled_label(card, widgets[i].description, PanelStyle::TEXT_CARD_DESC);
         lv_obj_align(desc, LV_ALIGN_BOTTOM_MID, 0, -5);
-        lv_obj_set_style_text_font(desc, &lv_font_montserrat_14, LV_PART_MAIN);
-        lv_obj_set_style_text_color(desc, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-        lv_obj_set_style_text_align(desc, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     }
+    
+    // Scene reports under the cards, stacked so each can grow with its text
+    lv_obj_update_layout(spawn_menu_root);
+    lv_obj_t* reports = lv_obj_create(spawn_menu_root);
+    lv_obj_set_size(reports, LV_PCT(100), LV_SIZE_CONTENT);
+    apply_style(reports, PanelStyle::TRANSPARENT);
+    lv_obj_clear_flag(reports, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_align(reports, LV_ALIGN_TOP_MID, 0, lv_obj_get_y2(grid_container) + 20);
+    lv_obj_set_flex_flow(reports, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(reports, 15, LV_PART_MAIN);
+    
+    // Render cost ranking; filled by the Measure button. Report buttons bypass the
+    // journal: they edit nothing, and their allocations are not the active object's.
+    lv_obj_t* cost_section = create_control_section(reports, " Render Cost", 0, 0);
+    lv_obj_t* measure_btn = create_modern_button(cost_section, " Measure", nullptr, 0xE67E22, 120, 40);
+    lv_obj_align(measure_btn, LV_ALIGN_TOP_RIGHT, 0, 0);
+    add_traced_event_cb(measure_btn, render_cost_event, LV_EVENT_CLICKED, "Measure render cost");
+    render_cost_label = create_styled_label(cost_section, "", PanelStyle::TEXT_VALUE);
+    lv_obj_align(render_cost_label, LV_ALIGN_TOP_LEFT, 0, 50);
+    refresh_render_cost_table();
+    
+    // LVGL heap and the scene's RAM bill; refreshed whenever the menu is shown
+    lv_obj_t* memory_section = create_control_section(reports, " Memory", 0, 0);
+    lv_obj_t* refresh_btn = create_modern_button(memory_section, " Refresh", nullptr, 0x16A085, 120, 40);
+    lv_obj_align(refresh_btn, LV_ALIGN_TOP_RIGHT, 0, 0);
+    add_traced_event_cb(refresh_btn, memory_refresh_event, LV_EVENT_CLICKED, "Refresh memory");
+    memory_label = create_styled_label(memory_section, "", PanelStyle::TEXT_VALUE);
+    lv_obj_align(memory_label, LV_ALIGN_TOP_LEFT, 0, 50);
+    refresh_memory_report();
+    
+    // Handler latency trace; Save writes it as Chrome trace JSON
+    lv_obj_t* trace_section = create_control_section(reports, " Event Trace", 0, 0);
+    lv_obj_t* save_btn = create_modern_button(trace_section, " Save", nullptr, 0x8E44AD, 120, 40);
+    lv_obj_align(save_btn, LV_ALIGN_TOP_RIGHT, 0, 0);
+    add_traced_event_cb(save_btn, trace_save_event, LV_EVENT_CLICKED, "Save trace");
+    trace_label = create_styled_label(trace_section, "", PanelStyle::TEXT_VALUE);
+    lv_obj_align(trace_label, LV_ALIGN_TOP_LEFT, 0, 50);
+    refresh_trace_report();
 }
 
 void DebugAlignmentEnhanced::create_object_controls() {
-    clear_content_area();
-    
-    if (active_object_index < 0 || active_object_index >= (int)spawned_objects.size()) {
+    if (!content_area) return;  // Panel not built yet; built on first open
+    SpawnedObject* active = active_object();
+    if (!active) {
         current_state = UIState::SPAWN_MENU;
         create_spawn_menu();
         return;
     }
     
-    SpawnedObject& obj = spawned_objects[active_object_index];
+    SpawnedObject& obj = *active;
+    
+    // Controls only depend on the widget type, so each type's tree is built once
+    // and re-bound to whichever object of that type is active
+    ControlPanel& panel = control_panels[(int)obj.type];
+    if (!panel.root) {
+        build_control_panel(panel, obj.type);
+    }
+    bind_control_panel(panel, obj);
+    show_content_root(panel.root);
+}
+
+void DebugAlignmentEnhanced::bind_control_panel(ControlPanel& panel, const SpawnedObject& obj) {
+    char title_text[64];
+    snprintf(title_text, sizeof(title_text), " %s", obj.name.c_str());
+    lv_label_set_text(panel.title_label, title_text);
+    
+    // Handlers resolve the active object on each event; only the shared pointers need re-pointing
+    widget_controls_parent = panel.widget_controls;
+    grid_label_ptr = panel.grid_label;
+    grid_toggle_label_ptr = panel.grid_toggle_label;
+    refresh_grid_labels();
+}
+
+void DebugAlignmentEnhanced::build_control_panel(ControlPanel& panel, WidgetType type) {
+    panel.root = create_content_root();
     
     // Modern header with object info
-    lv_obj_t* header = lv_obj_create(content_area);
+    lv_obj_t* header = lv_obj_create(panel.root);
     lv_obj_set_size(header, LV_PCT(100), 80);
     lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x2C3E50), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(header, LV_OPA_90, LV_PART_MAIN);
-    lv_obj_set_style_radius(header, 12, LV_PART_MAIN);
-    lv_obj_set_style_border_color(header, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(header, 2, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(header, 15, LV_PART_MAIN);
-    
-    // Object title
-    lv_obj_t* title = lv_label_create(header);
-    char title_text[64];
-    snprintf(title_text, sizeof(title_text), " %s", obj.name.c_str());
-    lv_label_set_text(title, title_text);
+    apply_style(header, PanelStyle::HEADER);
+    
+    // Object title (text is set when the panel is bound)
+    lv_obj_t* title = create_styled_label(header, "", PanelStyle::TEXT_HEADING);
+    panel.title_label = title;
     lv_obj_align(title, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_set_style_text_color(title, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, LV_PART_MAIN);
     
     // Action buttons in header
     lv_obj_t* btn_container = lv_obj_create(header);
     lv_obj_set_size(btn_container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
     lv_obj_align(btn_container, LV_ALIGN_TOP_RIGHT, 0, -5);
-    lv_obj_set_style_bg_opa(btn_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(btn_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(btn_container, 5, LV_PART_MAIN);
-    lv_obj_set_flex_flow(btn_container, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(btn_container, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_column(btn_container, 10, LV_PART_MAIN);
+    apply_style(btn_container, PanelStyle::ACTION_ROW);
     
     // Create modern action buttons
     create_modern_button(btn_container, " Back", back_to_menu_event, 0x95A5A6, 100, 40);
     create_modern_button(btn_container, " Delete", delete_active_event, 0xE74C3C, 100, 40);
     create_modern_button(btn_container, " Export", export_values_event, 0x27AE60, 100, 40);
+    // Not journaled themselves
+    lv_obj_t* undo_btn = create_modern_button(btn_container, " Undo", nullptr, 0x7F8C8D, 80, 40);
+    add_traced_event_cb(undo_btn, undo_event, LV_EVENT_CLICKED, "Undo");
+    lv_obj_t* redo_btn = create_modern_button(btn_container, " Redo", nullptr, 0x7F8C8D, 80, 40);
+    add_traced_event_cb(redo_btn, redo_event, LV_EVENT_CLICKED, "Redo");
     
     // Create tabbed interface for different control categories (simplified for older LVGL)
-    lv_obj_t* tab_view = lv_tabview_create(content_area);
+    lv_obj_t* tab_view = lv_tabview_create(panel.root);
     lv_obj_set_size(tab_view, LV_PCT(100), 520);
     lv_obj_align(tab_view, LV_ALIGN_TOP_MID, 0, 90);
-    lv_obj_set_style_bg_color(tab_view, lv_color_hex(0x34495E), LV_PART_MAIN);
-    lv_obj_set_style_radius(tab_view, 12, LV_PART_MAIN);
+    apply_style(tab_view, PanelStyle::TAB_VIEW);
     
     // Style the tab buttons
     lv_obj_t* tab_btns = lv_tabview_get_tab_btns(tab_view);
-    lv_obj_set_style_bg_color(tab_btns, lv_color_hex(0x2C3E50), LV_PART_MAIN);
-    lv_obj_set_style_text_color(tab_btns, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(tab_btns, &lv_font_montserrat_16, LV_PART_MAIN);
+    apply_style(tab_btns, PanelStyle::TAB_BAR);
     
-    // Tab 1: Transform Controls
-    lv_obj_t* tab_transform = lv_tabview_add_tab(tab_view, "Transform");
-    create_transform_controls(tab_transform);
+    // Tabs start empty; each is filled the first time it is shown
+    panel.tab_view = tab_view;
+    panel.tabs[(int)ControlTab::TRANSFORM] = lv_tabview_add_tab(tab_view, "Transform");
+    panel.tabs[(int)ControlTab::STYLE] = lv_tabview_add_tab(tab_view, "Style");
+    panel.tabs[(int)ControlTab::PROPERTIES] = lv_tabview_add_tab(tab_view, "Properties");
+    add_traced_event_cb(tab_view, control_tab_changed_event, LV_EVENT_VALUE_CHANGED, "Control tab");
+    build_control_tab(panel, ControlTab::TRANSFORM);
     
-    // Tab 2: Style Controls
-    lv_obj_t* tab_style = lv_tabview_add_tab(tab_view, "Style");
-    create_style_controls(tab_style);
+    DA_LOGD("Built control panel for %s", get_widget_type_name(type).c_str());
+}
+
+void DebugAlignmentEnhanced::build_control_tab(ControlPanel& panel, ControlTab tab) {
+    uint8_t bit = 1u << (int)tab;
+    if (panel.built_tabs & bit) return;
+    panel.built_tabs |= bit;
     
-    // Tab 3: Widget-specific Controls
-    lv_obj_t* tab_widget = lv_tabview_add_tab(tab_view, "Properties");
-    create_widget_specific_controls(tab_widget);
+    lv_obj_t* page = panel.tabs[(int)tab];
+    switch (tab) {
+        case ControlTab::TRANSFORM:
+            create_transform_controls(page);
+            break;
+        case ControlTab::STYLE:
+            // Only the bound panel's tabs can be shown, so the shared grid pointers belong to it
+            create_style_controls(page);
+            panel.grid_label = grid_label_ptr;
+            panel.grid_toggle_label = grid_toggle_label_ptr;
+            break;
+        case ControlTab::PROPERTIES:
+            create_widget_specific_controls(page);
+            panel.widget_controls = page;
+            break;
+        default:
+            break;
+    }
+}
+
+// The tab view tells which panel it belongs to (user_data carries the handler for tracing)
+void DebugAlignmentEnhanced::control_tab_changed_event(lv_event_t* e) {
+    lv_obj_t* tab_view = (lv_obj_t*)lv_event_get_current_target(e);
+    for (auto& panel : control_panels) {
+        if (!panel.tab_view || panel.tab_view != tab_view) continue;
+        uint32_t active = lv_tabview_get_tab_active(panel.tab_view);
+        if (active < (uint32_t)ControlTab::COUNT) {
+            build_control_tab(panel, (ControlTab)active);
+        }
+        return;
+    }
 }
 
 // Helper function to create modern styled buttons
@@ -327,28 +463,20 @@ lv_obj_t* DebugAlignmentEnhanced::create_modern_button(lv_obj_t* parent, const c
     lv_obj_set_size(btn, width, height);
     
     // Modern button styling
-    lv_obj_set_style_bg_color(btn, lv_color_hex(color), LV_PART_MAIN);
-    lv_obj_set_style_bg_grad_color(btn, lv_color_hex(color & 0x7F7F7F), LV_PART_MAIN);
-    lv_obj_set_style_bg_grad_dir(btn, LV_GRAD_DIR_VER, LV_PART_MAIN);
-    lv_obj_set_style_radius(btn, 8, LV_PART_MAIN);
-    lv_obj_set_style_border_color(btn, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_border_width(btn, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(btn, LV_OPA_30, LV_PART_MAIN);
-    lv_obj_set_style_shadow_color(btn, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_shadow_width(btn, 3, LV_PART_MAIN);
-    lv_obj_set_style_shadow_opa(btn, LV_OPA_30, LV_PART_MAIN);
+    apply_style(btn, PanelStyle::BUTTON);
+    apply_color_style(btn, color);
     
     // Hover effect
-    lv_obj_set_style_transform_zoom(btn, 105, LV_STATE_PRESSED);
+    apply_style(btn, PanelStyle::PRESSED, LV_STATE_PRESSED);
     
-    lv_obj_t* label = lv_label_create(btn);
-    lv_label_set_text(label, text);
+    lv_obj_t* label = create_styled_label(btn, text, PanelStyle::TEXT_BUTTON);
     lv_obj_center(label);
-    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, LV_PART_MAIN);
     
     if (callback) {
-        lv_obj_add_event_cb(btn, callback, LV_EVENT_CLICKED, nullptr);
+        // Routed through the journal so whatever the handler changes can be undone, and
+        // traced under the button's text
+        event_trace.intern(reinterpret_cast<const void*>(callback), text);
+        lv_obj_add_event_cb(btn, journaled_event, LV_EVENT_CLICKED, reinterpret_cast<void*>(callback));
     }
     
     return btn;
@@ -356,22 +484,13 @@ lv_obj_t* DebugAlignmentEnhanced::create_modern_button(lv_obj_t* parent, const c
 
 // Create transform controls tab content
 void DebugAlignmentEnhanced::create_transform_controls(lv_obj_t* parent) {
-    lv_obj_set_style_pad_all(parent, 20, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(parent, lv_color_hex(0x34495E), LV_PART_MAIN);
+    apply_style(parent, PanelStyle::TAB_PAGE);
     
     // Movement section
     lv_obj_t* move_section = create_control_section(parent, " Position", 0, 0);
     
     // Grid layout for movement buttons
-    lv_obj_t* move_grid = lv_obj_create(move_section);
-    lv_obj_set_size(move_grid, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(move_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(move_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(move_grid, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(move_grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(move_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(move_grid, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(move_grid, 10, LV_PART_MAIN);
+    lv_obj_t* move_grid = create_control_grid(move_section);
     
     // Movement buttons with icons
     create_modern_button(move_grid, " L", move_left_event, 0x3498DB, 70, 50);
@@ -386,18 +505,10 @@ void DebugAlignmentEnhanced::create_transform_controls(lv_obj_t* parent) {
     // Size section
     lv_obj_t* size_section = create_control_section(parent, " Size", 0, 150);
     
-    lv_obj_t* size_grid = lv_obj_create(size_section);
-    lv_obj_set_size(size_grid, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(size_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(size_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(size_grid, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(size_grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(size_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(size_grid, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(size_grid, 10, LV_PART_MAIN);
+    lv_obj_t* size_grid = create_control_grid(size_section);
     
     // Check if the selected object is an Arc widget
-    SpawnedObject* active_obj = get_active_object();
+    SpawnedObject* active_obj = active_object();
     bool is_arc_widget = (active_obj && active_obj->type == WidgetType::ARC);
     
     if (is_arc_widget) {
@@ -413,15 +524,7 @@ void DebugAlignmentEnhanced::create_transform_controls(lv_obj_t* parent) {
     // Alignment section
     lv_obj_t* align_section = create_control_section(parent, " Alignment", 0, 280);
     
-    lv_obj_t* align_grid = lv_obj_create(align_section);
-    lv_obj_set_size(align_grid, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(align_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(align_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(align_grid, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(align_grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(align_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(align_grid, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(align_grid, 10, LV_PART_MAIN);
+    lv_obj_t* align_grid = create_control_grid(align_section);
     
     // Snap buttons
     create_modern_button(align_grid, " Snap L", snap_left_event, 0x9B59B6, 100, 50);
@@ -431,29 +534,21 @@ void DebugAlignmentEnhanced::create_transform_controls(lv_obj_t* parent) {
     create_modern_button(align_grid, " Center H", snap_center_h_event, 0x8E44AD, 110, 50);
     create_modern_button(align_grid, " Center V", snap_center_v_event, 0x8E44AD, 110, 50);
     create_modern_button(align_grid, " Center", snap_center_event, 0x8E44AD, 100, 50);
+    create_modern_button(align_grid, " Guides", guide_snap_toggle_event, 0xFF4081, 100, 50);
 }
 
 // Create style controls tab content  
 void DebugAlignmentEnhanced::create_style_controls(lv_obj_t* parent) {
-    lv_obj_set_style_pad_all(parent, 20, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(parent, lv_color_hex(0x34495E), LV_PART_MAIN);
+    apply_style(parent, PanelStyle::TAB_PAGE);
     
     // Visibility section
     lv_obj_t* vis_section = create_control_section(parent, " Visibility", 0, 0);
     
-    lv_obj_t* vis_grid = lv_obj_create(vis_section);
-    lv_obj_set_size(vis_grid, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(vis_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(vis_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(vis_grid, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(vis_grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(vis_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(vis_grid, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(vis_grid, 10, LV_PART_MAIN);
+    lv_obj_t* vis_grid = create_control_grid(vis_section);
     
     create_modern_button(vis_grid, " Hide", toggle_visibility_event, 0xE74C3C, 100, 50);
     create_modern_button(vis_grid, " Show", [](lv_event_t*) { 
-        SpawnedObject* obj = get_active_object();
+        SpawnedObject* obj = active_object();
         if (!obj) return; 
         lv_obj_clear_flag(obj->object, LV_OBJ_FLAG_HIDDEN);
     }, 0x27AE60, 100, 50);
@@ -464,15 +559,7 @@ void DebugAlignmentEnhanced::create_style_controls(lv_obj_t* parent) {
     // Border & Effects section
     lv_obj_t* border_section = create_control_section(parent, " Border & Effects", 0, 120);
     
-    lv_obj_t* border_grid = lv_obj_create(border_section);
-    lv_obj_set_size(border_grid, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(border_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(border_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(border_grid, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(border_grid, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(border_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(border_grid, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(border_grid, 10, LV_PART_MAIN);
+    lv_obj_t* border_grid = create_control_grid(border_section);
     
     create_modern_button(border_grid, " B+", border_width_plus_event, 0xF39C12, 80, 50);
     create_modern_button(border_grid, " B-", border_width_minus_event, 0xF39C12, 80, 50);
@@ -484,39 +571,35 @@ void DebugAlignmentEnhanced::create_style_controls(lv_obj_t* parent) {
     // Grid section
     lv_obj_t* grid_section = create_control_section(parent, " Grid Snap", 0, 240);
     
-    lv_obj_t* grid_container = lv_obj_create(grid_section);
-    lv_obj_set_size(grid_container, LV_PCT(100), LV_SIZE_CONTENT);
-    lv_obj_set_style_bg_opa(grid_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(grid_container, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(grid_container, 10, LV_PART_MAIN);
-    lv_obj_set_flex_flow(grid_container, LV_FLEX_FLOW_ROW_WRAP);
-    lv_obj_set_flex_align(grid_container, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_style_pad_row(grid_container, 10, LV_PART_MAIN);
-    lv_obj_set_style_pad_column(grid_container, 10, LV_PART_MAIN);
-    
-    create_modern_button(grid_container, grid_snap_enabled ? " Grid:On" : " Grid:Off", snap_to_grid_event, grid_snap_enabled ? 0x27AE60 : 0xE74C3C, 120, 50);
+    lv_obj_t* grid_container = create_control_grid(grid_section);
+    
+    lv_obj_t* grid_btn = create_modern_button(grid_container, grid_snap_enabled ? " Grid:On" : " Grid:Off", snap_to_grid_event, grid_snap_enabled ? 0x27AE60 : 0xE74C3C, 120, 50);
+    grid_toggle_label_ptr = lv_obj_get_child(grid_btn, 0);
     create_modern_button(grid_container, " Size+", grid_size_plus_event, 0x3498DB, 100, 50);
     create_modern_button(grid_container, " Size-", grid_size_minus_event, 0x3498DB, 100, 50);
     
-    // Grid size label
-    if (!grid_label_ptr) {
-        grid_label_ptr = lv_label_create(grid_container);
-    } else {
-        lv_obj_set_parent(grid_label_ptr, grid_container);
+    // Grid size label (one per retained panel; refreshed when the panel is bound)
+    grid_label_ptr = create_styled_label(grid_container, "", PanelStyle::TEXT_VALUE);
+    refresh_grid_labels();
+}
+
+// Grid state is global, so every retained panel shows it; update the bound one in-place
+void DebugAlignmentEnhanced::refresh_grid_labels() {
+    if (grid_label_ptr) {
+        char gtxt[32];
+        snprintf(gtxt, sizeof(gtxt), " Size: %d%s", grid_size, grid_snap_enabled ? " (On)" : " (Off)");
+        lv_label_set_text(grid_label_ptr, gtxt);
+    }
+    if (grid_toggle_label_ptr) {
+        lv_label_set_text(grid_toggle_label_ptr, grid_snap_enabled ? " Grid:On" : " Grid:Off");
     }
-    char gtxt[32];
-    snprintf(gtxt, sizeof(gtxt), " Size: %d", grid_size);
-    lv_label_set_text(grid_label_ptr, gtxt);
-    lv_obj_set_style_text_color(grid_label_ptr, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(grid_label_ptr, &lv_font_montserrat_16, LV_PART_MAIN);
 }
 
 // Create widget-specific controls tab content
 void DebugAlignmentEnhanced::create_widget_specific_controls(lv_obj_t* parent) {
-    lv_obj_set_style_pad_all(parent, 20, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(parent, lv_color_hex(0x34495E), LV_PART_MAIN);
+    apply_style(parent, PanelStyle::TAB_PAGE);
     
-    if (active_object_index < 0 || active_object_index >= (int)spawned_objects.size()) return;
+    if (!active_object()) return;
     
     widget_controls_parent = parent;  // Set the parent for widget controls
     update_controls_for_active_object();
@@ -529,32 +612,23 @@ lv_obj_t* DebugAlignmentEnhanced::create_control_section(lv_obj_t* parent, const
     lv_obj_align(section, LV_ALIGN_TOP_LEFT, x, y);
     
     // Modern section styling
-    lv_obj_set_style_bg_color(section, lv_color_hex(0x2C3E50), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(section, LV_OPA_60, LV_PART_MAIN);
-    lv_obj_set_style_radius(section, 10, LV_PART_MAIN);
-    lv_obj_set_style_border_color(section, lv_color_hex(0x3498DB), LV_PART_MAIN);
-    lv_obj_set_style_border_width(section, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(section, LV_OPA_50, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(section, 15, LV_PART_MAIN);
+    apply_style(section, PanelStyle::SECTION);
     
     // Section title
-    lv_obj_t* title_label = lv_label_create(section);
-    lv_label_set_text(title_label, title);
+    lv_obj_t* title_label = create_styled_label(section, title, PanelStyle::TEXT_SECTION);
     lv_obj_align(title_label, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_set_style_text_color(title_label, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_20, LV_PART_MAIN);
     
     return section;
 }
 
 void DebugAlignmentEnhanced::update_controls_for_active_object() {
-    if (active_object_index < 0 || active_object_index >= (int)spawned_objects.size()) return;
-    if (!widget_controls_parent) return;
+    SpawnedObject* active = active_object();
+    if (!active || !widget_controls_parent) return;
     
     // Clear existing widget-specific controls
     lv_obj_clean(widget_controls_parent);
     
-    SpawnedObject& obj = spawned_objects[active_object_index];
+    SpawnedObject& obj = *active;
     
     // Widget-specific controls based on type
     switch (obj.type) {
@@ -562,15 +636,7 @@ void DebugAlignmentEnhanced::update_controls_for_active_object() {
             // Arc Properties section
             lv_obj_t* arc_section = create_control_section(widget_controls_parent, " Arc Properties", 0, 0);
             
-            lv_obj_t* arc_grid = lv_obj_create(arc_section);
-            lv_obj_set_size(arc_grid, LV_PCT(100), LV_SIZE_CONTENT);
-            lv_obj_set_style_bg_opa(arc_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_border_opa(arc_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_pad_all(arc_grid, 10, LV_PART_MAIN);
-            lv_obj_set_flex_flow(arc_grid, LV_FLEX_FLOW_ROW_WRAP);
-            lv_obj_set_flex_align(arc_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-            lv_obj_set_style_pad_row(arc_grid, 10, LV_PART_MAIN);
-            lv_obj_set_style_pad_column(arc_grid, 10, LV_PART_MAIN);
+            lv_obj_t* arc_grid = create_control_grid(arc_section);
             
             // Range controls
             create_modern_button(arc_grid, " Min+", arc_range_min_plus_event, 0x3498DB, 100, 50);
@@ -616,15 +682,7 @@ void DebugAlignmentEnhanced::update_controls_for_active_object() {
             
             lv_obj_t* bar_section = create_control_section(widget_controls_parent, section_title, 0, 0);
             
-            lv_obj_t* bar_grid = lv_obj_create(bar_section);
-            lv_obj_set_size(bar_grid, LV_PCT(100), LV_SIZE_CONTENT);
-            lv_obj_set_style_bg_opa(bar_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_border_opa(bar_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_pad_all(bar_grid, 10, LV_PART_MAIN);
-            lv_obj_set_flex_flow(bar_grid, LV_FLEX_FLOW_ROW_WRAP);
-            lv_obj_set_flex_align(bar_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-            lv_obj_set_style_pad_row(bar_grid, 10, LV_PART_MAIN);
-            lv_obj_set_style_pad_column(bar_grid, 10, LV_PART_MAIN);
+            lv_obj_t* bar_grid = create_control_grid(bar_section);
             
             // Range controls
             create_modern_button(bar_grid, " Min+", bar_min_plus_event, 0x3498DB, 100, 50);
@@ -657,15 +715,7 @@ void DebugAlignmentEnhanced::update_controls_for_active_object() {
             
             lv_obj_t* state_section = create_control_section(widget_controls_parent, section_title, 0, 0);
             
-            lv_obj_t* state_grid = lv_obj_create(state_section);
-            lv_obj_set_size(state_grid, LV_PCT(100), LV_SIZE_CONTENT);
-            lv_obj_set_style_bg_opa(state_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_border_opa(state_grid, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_pad_all(state_grid, 10, LV_PART_MAIN);
-            lv_obj_set_flex_flow(state_grid, LV_FLEX_FLOW_ROW_WRAP);
-            lv_obj_set_flex_align(state_grid, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-            lv_obj_set_style_pad_row(state_grid, 10, LV_PART_MAIN);
-            lv_obj_set_style_pad_column(state_grid, 10, LV_PART_MAIN);
+            lv_obj_t* state_grid = create_control_grid(state_section);
             
             if (obj.type == WidgetType::BUTTON) {
                 create_modern_button(state_grid, " Toggle", button_toggle_state_event, 0x3498DB, 120, 50);
@@ -679,16 +729,61 @@ void DebugAlignmentEnhanced::update_controls_for_active_object() {
             break;
         }
         
+        case WidgetType::CANVAS: {
+            lv_obj_t* canvas_section = create_control_section(widget_controls_parent, " Canvas Properties", 0, 0);
+            
+            lv_obj_t* canvas_grid = create_control_grid(canvas_section);
+            
+            // Buffer: RGB565 -> ARGB8888 -> L8, and resize to the transform size
+            create_modern_button(canvas_grid, " Format", canvas_format_cycle_event, 0x3498DB, 110, 50);
+            create_modern_button(canvas_grid, " Recreate", canvas_recreate_event, 0x9B59B6, 120, 50);
+            
+            // Contents: plain fill color, test patterns, back to the plain fill
+            create_modern_button(canvas_grid, " Fill", canvas_fill_color_event, 0x27AE60, 90, 50);
+            create_modern_button(canvas_grid, " Pattern", canvas_draw_test_event, 0xF39C12, 110, 50);
+            create_modern_button(canvas_grid, " Clear", canvas_clear_event, 0x95A5A6, 100, 50);
+            break;
+        }
+        
+        case WidgetType::CHART: {
+            lv_obj_t* chart_section = create_control_section(widget_controls_parent, " Chart Properties", 0, 0);
+            
+            lv_obj_t* chart_grid = create_control_grid(chart_section);
+            
+            // Points and value range
+            create_modern_button(chart_grid, " Pts+", chart_point_count_plus_event, 0x3498DB, 90, 50);
+            create_modern_button(chart_grid, " Pts-", chart_point_count_minus_event, 0x3498DB, 90, 50);
+            create_modern_button(chart_grid, " Min+", chart_y_min_plus_event, 0x27AE60, 100, 50);
+            create_modern_button(chart_grid, " Min-", chart_y_min_minus_event, 0x27AE60, 100, 50);
+            create_modern_button(chart_grid, " Max+", chart_y_max_plus_event, 0x27AE60, 100, 50);
+            create_modern_button(chart_grid, " Max-", chart_y_max_minus_event, 0x27AE60, 100, 50);
+            
+            // Look
+            create_modern_button(chart_grid, " Type", chart_toggle_type_event, 0x9B59B6, 100, 50);
+            create_modern_button(chart_grid, " Div+", chart_div_lines_plus_event, 0x9B59B6, 90, 50);
+            create_modern_button(chart_grid, " Div-", chart_div_lines_minus_event, 0x9B59B6, 90, 50);
+            create_modern_button(chart_grid, " Ser+", chart_add_series_event, 0xE67E22, 90, 50);
+            create_modern_button(chart_grid, " Ser-", chart_remove_series_event, 0xE67E22, 90, 50);
+            
+            // Synthetic feed into every series, circular or shift
+            create_modern_button(chart_grid, " Mode", chart_toggle_update_mode_event, 0xF39C12, 100, 50);
+            create_modern_button(chart_grid, " Rate+", chart_feed_rate_plus_event, 0xF39C12, 100, 50);
+            create_modern_button(chart_grid, " Rate-", chart_feed_rate_minus_event, 0xF39C12, 100, 50);
+            create_modern_button(chart_grid, " Decim", chart_toggle_decimation_event, 0xF39C12, 100, 50);
+            
+            // Achieved rate and draw cost, refreshed once per second by the feed timer
+            chart_readout_label = create_styled_label(chart_section, "", PanelStyle::TEXT_SMALL);
+            lv_obj_add_event_cb(chart_readout_label, chart_readout_deleted_event, LV_EVENT_DELETE, nullptr);
+            refresh_chart_readout();
+            break;
+        }
+        
         default:
             // For other widget types, show a modern placeholder
             lv_obj_t* placeholder_section = create_control_section(widget_controls_parent, " Widget Properties", 0, 0);
             
-            lv_obj_t* placeholder = lv_label_create(placeholder_section);
-            lv_label_set_text(placeholder, " Basic controls only\nUse Transform and Style tabs for customization");
+            lv_obj_t* placeholder = create_styled_label(placeholder_section, " Basic controls only\nUse Transform and Style tabs for customization", PanelStyle::TEXT_SMALL);
             lv_obj_align(placeholder, LV_ALIGN_CENTER, 0, 10);
-            lv_obj_set_style_text_color(placeholder, lv_color_hex(0xBDC3C7), LV_PART_MAIN);
-            lv_obj_set_style_text_font(placeholder, &lv_font_montserrat_14, LV_PART_MAIN);
-            lv_obj_set_style_text_align(placeholder, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
             break;
     }
 }
@@ -697,160 +792,211 @@ void DebugAlignmentEnhanced::create_object_list() {
     lv_obj_clean(object_list_area);
     
     // Modern header title
-    lv_obj_t* header_title = lv_label_create(object_list_area);
-    lv_label_set_text(header_title, " Debug Toolkit");
+    lv_obj_t* header_title = create_styled_label(object_list_area, " Debug Toolkit", PanelStyle::TEXT_HEADING);
     lv_obj_align(header_title, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_set_style_text_color(header_title, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_text_font(header_title, &lv_font_montserrat_24, LV_PART_MAIN);
     
     // Subtitle
-    lv_obj_t* subtitle = lv_label_create(object_list_area);
-    lv_label_set_text(subtitle, "Manage your UI elements");
+    lv_obj_t* subtitle = create_styled_label(object_list_area, "Manage your UI elements", PanelStyle::TEXT_SMALL);
     lv_obj_align(subtitle, LV_ALIGN_TOP_LEFT, 0, 30);
-    lv_obj_set_style_text_color(subtitle, lv_color_hex(0xBDC3C7), LV_PART_MAIN);
-    lv_obj_set_style_text_font(subtitle, &lv_font_montserrat_14, LV_PART_MAIN);
     
     // Create "New Widget" button with modern styling
     lv_obj_t* new_btn = lv_btn_create(object_list_area);
     lv_obj_set_size(new_btn, 120, 45);
     lv_obj_align(new_btn, LV_ALIGN_TOP_RIGHT, 0, 0);
-    lv_obj_add_event_cb(new_btn, back_to_menu_event, LV_EVENT_CLICKED, nullptr);
+    add_traced_event_cb(new_btn, back_to_menu_event, LV_EVENT_CLICKED, "New Widget");
     
     // Modern button styling
-    lv_obj_set_style_bg_color(new_btn, lv_color_hex(0x27AE60), LV_PART_MAIN);
-    lv_obj_set_style_bg_grad_color(new_btn, lv_color_hex(0x2ECC71), LV_PART_MAIN);
-    lv_obj_set_style_bg_grad_dir(new_btn, LV_GRAD_DIR_VER, LV_PART_MAIN);
-    lv_obj_set_style_radius(new_btn, 12, LV_PART_MAIN);
-    lv_obj_set_style_border_color(new_btn, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-    lv_obj_set_style_border_width(new_btn, 2, LV_PART_MAIN);
-    lv_obj_set_style_border_opa(new_btn, LV_OPA_30, LV_PART_MAIN);
-    lv_obj_set_style_shadow_color(new_btn, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_shadow_width(new_btn, 5, LV_PART_MAIN);
-    lv_obj_set_style_shadow_opa(new_btn, LV_OPA_30, LV_PART_MAIN);
+    apply_style(new_btn, PanelStyle::NEW_BUTTON);
     
     // Hover effect
-    lv_obj_set_style_transform_zoom(new_btn, 105, LV_STATE_PRESSED);
+    apply_style(new_btn, PanelStyle::PRESSED, LV_STATE_PRESSED);
     
-    lv_obj_t* new_label = lv_label_create(new_btn);
-    lv_label_set_text(new_label, " New Widget");
+    lv_obj_t* new_label = create_styled_label(new_btn, " New Widget", PanelStyle::TEXT_BUTTON);
     lv_obj_center(new_label);
-    lv_obj_set_style_text_color(new_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(new_label, &lv_font_montserrat_14, LV_PART_MAIN);
+    
+    // Shown instead of the strip while nothing has been spawned
+    object_list_empty_label = create_styled_label(object_list_area, "No widgets created yet", PanelStyle::TEXT_MUTED);
+    lv_obj_align(object_list_empty_label, LV_ALIGN_TOP_LEFT, 200, 20);
+    
+    // Horizontally scrolling strip between the header text and the "New Widget" button.
+    // It holds a fixed pool of chips no matter how many objects exist.
+    object_strip = lv_obj_create(object_list_area);
+    lv_obj_set_size(object_strip, 430, 36);
+    lv_obj_align(object_strip, LV_ALIGN_TOP_LEFT, 200, 0);
+    apply_style(object_strip, PanelStyle::TRANSPARENT);
+    lv_obj_set_scroll_dir(object_strip, LV_DIR_HOR);
+    lv_obj_set_scrollbar_mode(object_strip, LV_SCROLLBAR_MODE_AUTO);
+    add_traced_event_cb(object_strip, object_strip_scroll_event, LV_EVENT_SCROLL, "Object strip scroll");
+    
+    object_strip_spacer = lv_obj_create(object_strip);
+    lv_obj_set_size(object_strip_spacer, 1, 1);
+    lv_obj_set_pos(object_strip_spacer, 0, 0);
+    apply_style(object_strip_spacer, PanelStyle::TRANSPARENT);
+    lv_obj_clear_flag(object_strip_spacer, LV_OBJ_FLAG_CLICKABLE);
+    
+    for (auto& slot : object_chips) {
+        lv_obj_t* obj_chip = lv_btn_create(object_strip);
+        lv_obj_set_size(obj_chip, 100, 30);
+        lv_obj_add_flag(obj_chip, LV_OBJ_FLAG_HIDDEN);
+        
+        // Chip styling shared by active and inactive chips
+        apply_style(obj_chip, PanelStyle::CHIP);
+        apply_style(obj_chip, PanelStyle::CHIP_INACTIVE);
+        
+        // Hover effect
+        apply_style(obj_chip, PanelStyle::PRESSED, LV_STATE_PRESSED);
+        
+        // A tap resolves the chip's slot, not an index: the slot knows what it is bound to
+        add_traced_event_cb(obj_chip, object_chip_clicked_event, LV_EVENT_CLICKED, "Object chip");
+        
+        lv_obj_t* obj_label = create_styled_label(obj_chip, "", PanelStyle::TEXT_BUTTON);
+        lv_obj_center(obj_label);
+        
+        slot = ObjectChip();
+        slot.chip = obj_chip;
+        slot.label = obj_label;
+    }
+    
+    // Frame timing under the chips, and the redraw heatmap switch beside them
+    create_perf_strip(object_list_area);
+    lv_obj_t* heat_btn = create_modern_button(object_list_area, get_redraw_heatmap() ? " Heat On" : " Heat",
+                                              nullptr, 0xD7191C, 90, 36);
+    lv_obj_align(heat_btn, LV_ALIGN_TOP_LEFT, 640, 0);
+    add_traced_event_cb(heat_btn, heatmap_toggle_event, LV_EVENT_CLICKED, "Redraw heatmap");
+    heatmap_button_label = lv_obj_get_child(heat_btn, 0);
     
     update_object_list();
 }
 
 void DebugAlignmentEnhanced::update_object_list() {
-    if (!object_list_area) return;
+    if (!object_strip) return;
     
-    printf("[DEBUG] Updating object list...\n");
+    int count = (int)spawned_objects.size();
     
-    // Clear existing object buttons (but keep the header and "New" button)
-    uint32_t child_count = lv_obj_get_child_count(object_list_area);
-    for (uint32_t i = child_count; i > 3; i--) {  // Keep first 3 children (title, subtitle, new button)
-        lv_obj_t* child = lv_obj_get_child(object_list_area, i - 1);
-        if (child) {
-            lv_obj_delete(child);
+    if (count == 0) {
+        lv_obj_clear_flag(object_list_empty_label, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(object_strip, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(object_list_empty_label, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(object_strip, LV_OBJ_FLAG_HIDDEN);
+    }
+    
+    // The spacer gives the strip its full scroll range; only the pooled chips are real
+    int content_w = std::max(1, count * OBJECT_CHIP_PITCH - 10);
+    if (lv_obj_get_width(object_strip_spacer) != content_w) {
+        lv_obj_set_width(object_strip_spacer, content_w);
+        lv_obj_update_layout(object_strip);
+    }
+    
+    // Keep the active chip in view (e.g. right after spawning at the end of the list)
+    int active_position = spawned_objects.position_of(active_handle);
+    if (active_position >= 0) {
+        int strip_w = lv_obj_get_content_width(object_strip);
+        int scroll_x = lv_obj_get_scroll_x(object_strip);
+        int chip_x = active_position * OBJECT_CHIP_PITCH;
+        if (chip_x < scroll_x || chip_x + OBJECT_CHIP_PITCH - 10 > scroll_x + strip_w) {
+            lv_obj_scroll_to_x(object_strip, std::max(0, chip_x + OBJECT_CHIP_PITCH - strip_w), LV_ANIM_OFF);
         }
     }
     
-    printf("[DEBUG] Cleared existing buttons, creating new ones...\n");
+    sync_object_chips();
+}
+
+// Bind the pooled chips to the objects in the visible window. Each index always maps to
+// pool slot (index % OBJECT_CHIP_POOL), so scrolling one chip re-binds one slot, and a
+// slot whose object, name and active state are unchanged is not touched at all.
+void DebugAlignmentEnhanced::sync_object_chips() {
+    int count = (int)spawned_objects.size();
+    int first = std::max(0, (int)lv_obj_get_scroll_x(object_strip)) / OBJECT_CHIP_PITCH;
     
-    if (spawned_objects.empty()) {
-        // Show "No objects" message
-        lv_obj_t* empty_label = lv_label_create(object_list_area);
-        lv_label_set_text(empty_label, "No widgets created yet");
-        lv_obj_align(empty_label, LV_ALIGN_TOP_LEFT, 200, 20);
-        lv_obj_set_style_text_color(empty_label, lv_color_hex(0x95A5A6), LV_PART_MAIN);
-        lv_obj_set_style_text_font(empty_label, &lv_font_montserrat_14, LV_PART_MAIN);
+    for (int i = first; i < first + OBJECT_CHIP_POOL; i++) {
+        ObjectChip& slot = object_chips[i % OBJECT_CHIP_POOL];
+        bind_object_chip(slot, i < count ? i : -1);
+    }
+}
+
+void DebugAlignmentEnhanced::bind_object_chip(ObjectChip& slot, int index) {
+    if (index < 0) {
+        if (slot.bound_index >= 0) {
+            lv_obj_add_flag(slot.chip, LV_OBJ_FLAG_HIDDEN);
+            slot.bound_index = -1;
+            slot.bound_handle = ObjectHandle();
+        }
         return;
     }
     
-    // Create object chips/buttons in a horizontal layout
-    int x_pos = 10;
-    int y_pos = 55;  // Below the header
-    
-    for (size_t i = 0; i < spawned_objects.size() && i < 6; i++) {  // Limit to 6 visible objects
-        lv_obj_t* obj_chip = lv_btn_create(object_list_area);
-        lv_obj_set_size(obj_chip, 100, 30);
-        lv_obj_set_pos(obj_chip, x_pos, y_pos);
-        
-        // Chip styling
-        if ((int)i == active_object_index) {
-            // Active object styling
-            lv_obj_set_style_bg_color(obj_chip, lv_color_hex(0x3498DB), LV_PART_MAIN);
-            lv_obj_set_style_bg_grad_color(obj_chip, lv_color_hex(0x2980B9), LV_PART_MAIN);
-            lv_obj_set_style_border_color(obj_chip, lv_color_hex(0xECF0F1), LV_PART_MAIN);
-            lv_obj_set_style_border_width(obj_chip, 2, LV_PART_MAIN);
-        } else {
-            // Inactive object styling
-            lv_obj_set_style_bg_color(obj_chip, lv_color_hex(0x95A5A6), LV_PART_MAIN);
-            lv_obj_set_style_bg_grad_color(obj_chip, lv_color_hex(0x7F8C8D), LV_PART_MAIN);
-            lv_obj_set_style_border_color(obj_chip, lv_color_hex(0xBDC3C7), LV_PART_MAIN);
-            lv_obj_set_style_border_width(obj_chip, 1, LV_PART_MAIN);
+    if (slot.bound_index != index) {
+        if (slot.bound_index < 0) {
+            lv_obj_clear_flag(slot.chip, LV_OBJ_FLAG_HIDDEN);
         }
-        
-        lv_obj_set_style_bg_grad_dir(obj_chip, LV_GRAD_DIR_VER, LV_PART_MAIN);
-        lv_obj_set_style_radius(obj_chip, 15, LV_PART_MAIN);
-        lv_obj_set_style_border_opa(obj_chip, LV_OPA_50, LV_PART_MAIN);
-        lv_obj_set_style_shadow_color(obj_chip, lv_color_hex(0x000000), LV_PART_MAIN);
-        lv_obj_set_style_shadow_width(obj_chip, 3, LV_PART_MAIN);
-        lv_obj_set_style_shadow_opa(obj_chip, LV_OPA_20, LV_PART_MAIN);
-        
-        // Hover effect
-        lv_obj_set_style_transform_zoom(obj_chip, 105, LV_STATE_PRESSED);
-        
-        // Store index in user data for the event handler
-        lv_obj_set_user_data(obj_chip, (void*)(uintptr_t)i);
-        lv_obj_add_event_cb(obj_chip, [](lv_event_t* e) {
-            lv_obj_t* target = (lv_obj_t*)lv_event_get_target(e);
-            int index = (int)(uintptr_t)lv_obj_get_user_data(target);
-            set_active_object(index);
-        }, LV_EVENT_CLICKED, nullptr);
-        
-        lv_obj_t* obj_label = lv_label_create(obj_chip);
-        
+        lv_obj_set_pos(slot.chip, index * OBJECT_CHIP_PITCH, 0);
+        slot.bound_index = index;
+    }
+    // A delete can move another object into this position without moving the chip
+    slot.bound_handle = spawned_objects.handle_at(index);
+    
+    const SpawnedObject& obj = spawned_objects.at(index);
+    if (slot.shown_name != obj.name) {
         // Create shortened name for display
-        std::string display_name = spawned_objects[i].name;
+        std::string display_name = obj.name;
         if (display_name.length() > 8) {
             display_name = display_name.substr(0, 8) + "...";
         }
-        
-        lv_label_set_text(obj_label, display_name.c_str());
-        lv_obj_center(obj_label);
-        lv_obj_set_style_text_color(obj_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        lv_obj_set_style_text_font(obj_label, &lv_font_montserrat_14, LV_PART_MAIN);
-        
-        x_pos += 110;
-        if (x_pos > 650) {  // Wrap to next row if needed
-            x_pos = 10;
-            y_pos += 35;
-        }
+        lv_label_set_text(slot.label, display_name.c_str());
+        slot.shown_name = obj.name;
     }
     
-    // Show count if there are more objects
-    if (spawned_objects.size() > 6) {
-        lv_obj_t* more_label = lv_label_create(object_list_area);
-        char more_text[32];
-        snprintf(more_text, sizeof(more_text), "+%d more", (int)(spawned_objects.size() - 6));
-        lv_label_set_text(more_label, more_text);
-        lv_obj_set_pos(more_label, x_pos, y_pos);
-        lv_obj_set_style_text_color(more_label, lv_color_hex(0x95A5A6), LV_PART_MAIN);
-        lv_obj_set_style_text_font(more_label, &lv_font_montserrat_14, LV_PART_MAIN);
+    bool active = (slot.bound_handle == active_handle);
+    if (slot.shown_active != active) {
+        style_object_chip(slot.chip, active);
+        slot.shown_active = active;
+    }
+}
+
+// Swap the shared active/inactive style instead of rewriting local properties
+void DebugAlignmentEnhanced::style_object_chip(lv_obj_t* chip, bool active) {
+    PanelStyle from = active ? PanelStyle::CHIP_INACTIVE : PanelStyle::CHIP_ACTIVE;
+    PanelStyle to = active ? PanelStyle::CHIP_ACTIVE : PanelStyle::CHIP_INACTIVE;
+    remove_style(chip, from);
+    apply_style(chip, to);
+}
+
+void DebugAlignmentEnhanced::object_strip_scroll_event(lv_event_t*) {
+    sync_object_chips();
+}
+
+void DebugAlignmentEnhanced::object_chip_clicked_event(lv_event_t* e) {
+    lv_obj_t* chip = (lv_obj_t*)lv_event_get_current_target(e);
+    for (const auto& slot : object_chips) {
+        if (slot.chip != chip) continue;
+        if (slot.bound_index >= 0) set_active_object(slot.bound_handle);
+        return;
     }
 }
 
 void DebugAlignmentEnhanced::spawn_widget(WidgetType type) {
     if (!parent_screen) return;
     
+    // Everything LVGL allocates from here to set_active_object() is this object's
+    HeapMark mark = heap_mark();
     lv_obj_t* widget = create_widget_instance(type, parent_screen);
     if (!widget) return;
     
     SpawnedObject obj;
     obj.type = type;
     obj.object = widget;
-    obj.index = spawned_objects.size();
-    obj.name = get_widget_type_name(type) + " #" + std::to_string(obj.index + 1);
+    obj.serial = ++spawn_serial;
+    obj.name = get_widget_type_name(type) + " #" + std::to_string(obj.serial);
+    
+    // Initialize widget-specific properties based on type
+    obj.props = default_props(type);
+    if (type == WidgetType::CANVAS) {
+        if (!attach_canvas_buffer(obj)) {
+            lv_obj_delete(widget);
+            return;
+        }
+        paint_canvas(obj);
+    }
     
     // Position the widget at center manually (not using alignment)
     lv_coord_t screen_w = lv_obj_get_width(parent_screen);
@@ -871,37 +1017,34 @@ void DebugAlignmentEnhanced::spawn_widget(WidgetType type) {
     obj.transform.rotation = 0;  // Fix: Initialize rotation to 0
     obj.transform.pad = 0;       // Also initialize pad for completeness
     
-    // Initialize widget-specific properties based on type
+    ObjectHandle handle = spawned_objects.insert(std::move(obj));
+    SpawnedObject& spawned = *spawned_objects.get(handle);
+    spawned.handle = handle;
+    reindex_object(spawned);
+    if (type == WidgetType::CHART) {
+        // Div lines differ from lv_chart's defaults; the rest already match the props
+        apply_chart_props(spawned);
+    }
+    spawned.heap_bytes = heap_since(mark);
+    set_active_object(handle);
+    
+    DA_LOGD("Spawned %s", spawned.name.c_str());
+}
+
+WidgetProps DebugAlignmentEnhanced::default_props(WidgetType type) {
     switch (type) {
-        case WidgetType::ARC:
-            obj.props.start_angle = 0;
-            obj.props.end_angle = 270;
-            obj.props.arc_width = 15;
-            obj.props.track_width = 5;
-            obj.props.track_visible = true;
-            obj.props.rounded_caps = false;
-            obj.props.value = 50;
-            obj.props.range_min = 0;
-            obj.props.range_max = 100;
-            obj.props.rotation = 0;  // Also store in props for consistency
-            break;
+        case WidgetType::ARC: return ArcProps();
         case WidgetType::BAR:
-        case WidgetType::SLIDER:
-            obj.props.min_value = 0;
-            obj.props.max_value = 100;
-            obj.props.current_value = 50;
-            obj.props.horizontal = true;
-            break;
-        default:
-            // Initialize common properties to safe defaults
-            obj.props.state = false;
-            break;
+        case WidgetType::SLIDER: return BarProps();
+        case WidgetType::CANVAS: return CanvasProps();
+        case WidgetType::CHART: return ChartProps();
+        case WidgetType::TABLE: return TableProps();
+        case WidgetType::SPINNER: return SpinnerProps();
+        case WidgetType::SPIN_BOX: return SpinboxProps();
+        case WidgetType::MESSAGE_BOX: return MsgBoxProps();
+        case WidgetType::PIE_CHART: return PieProps();
+        default: return ToggleProps();
     }
-    
-    spawned_objects.push_back(obj);
-    set_active_object(spawned_objects.size() - 1);
-    
-    printf("[DEBUG] Spawned %s\n", obj.name.c_str());
 }
 
 lv_obj_t* DebugAlignmentEnhanced::create_widget_instance(WidgetType type, lv_obj_t* parent) {
@@ -931,13 +1074,9 @@ lv_obj_t* DebugAlignmentEnhanced::create_widget_instance(WidgetType type, lv_obj
             return btn;
         }
         
-        case WidgetType::CANVAS: {
-            lv_obj_t* canvas = lv_canvas_create(parent);
-            static lv_color_t canvas_buf[200 * 150];
-            lv_canvas_set_buffer(canvas, canvas_buf, 200, 150, LV_COLOR_FORMAT_RGB565);
-            lv_canvas_fill_bg(canvas, lv_color_hex(0x333333), LV_OPA_COVER);
-            return canvas;
-        }
+        case WidgetType::CANVAS:
+            // The buffer comes from canvas_pool once the props are known (attach_canvas_buffer)
+            return lv_canvas_create(parent);
         
         case WidgetType::CHART: {
             lv_obj_t* chart = lv_chart_create(parent);
@@ -1043,143 +1182,314 @@ std::string DebugAlignmentEnhanced::get_widget_type_name(WidgetType type) {
     }
 }
 
-void DebugAlignmentEnhanced::set_active_object(int index) {
-    if (index < 0 || index >= (int)spawned_objects.size()) return;
+void DebugAlignmentEnhanced::set_active_object(ObjectHandle handle) {
+    SpawnedObject* obj = spawned_objects.get(handle);
+    if (!obj) return;
     
-    active_object_index = index;
+    active_handle = handle;
     current_state = UIState::OBJECT_CONTROLS;
+    show_guides(GuideLine(), GuideLine());  // Guides belonged to the previous object
+    journal.break_merge();
     
-    printf("[DEBUG] Setting active object to index %d: %s\n", index, spawned_objects[index].name.c_str());
+    DA_LOGD("Setting active object to %s", obj->name.c_str());
     
     create_object_controls();
     update_object_list();
     
-    printf("[DEBUG] Active object set successfully\n");
+    DA_LOGD("Active object set successfully");
+}
+
+// Deletes every spawned object along with its indexes and edit history
+void DebugAlignmentEnhanced::clear_spawned_objects() {
+    for (auto& obj : spawned_objects) {
+        if (obj.object) {
+            canvas_pool.release(obj.object);
+            lv_obj_delete(obj.object);
+        }
+    }
+    spawned_objects.clear();
+    chart_feeds.clear();
+    render_costs.clear();
+    codegen_fragments.clear();
+    journal.clear();
+    spatial_index.clear();
+    edge_index.clear();
+    active_handle = ObjectHandle();
+    spawn_serial = 0;
 }
 
 void DebugAlignmentEnhanced::delete_active_object() {
-    if (active_object_index < 0 || active_object_index >= (int)spawned_objects.size()) return;
-    
-    SpawnedObject& obj = spawned_objects[active_object_index];
-    printf("[DEBUG] Deleting object: %s\n", obj.name.c_str());
+    SpawnedObject* obj = active_object();
+    if (!obj) return;
+    DA_LOGD("Deleting object: %s", obj->name.c_str());
     
-    if (obj.object) {
-        lv_obj_delete(obj.object);
+    if (obj->object) {
+        canvas_pool.release(obj->object);
+        lv_obj_delete(obj->object);
     }
     
-    spawned_objects.erase(spawned_objects.begin() + active_object_index);
+    // Later objects move up one list position; handles and names are unaffected
+    int position = spawned_objects.position_of(active_handle);
+    spatial_index.remove(active_handle);
+    edge_index.remove(active_handle);
+    spawned_objects.erase(active_handle);
     
-    // Update indices
-    for (size_t i = 0; i < spawned_objects.size(); i++) {
-        spawned_objects[i].index = i;
-        spawned_objects[i].name = get_widget_type_name(spawned_objects[i].type) + " #" + std::to_string(i + 1);
-    }
-    
-    // Set new active object or go back to menu
+    // Select the object that followed the deleted one (or the new last) or go back to menu
     if (spawned_objects.empty()) {
-        active_object_index = -1;
+        active_handle = ObjectHandle();
         current_state = UIState::SPAWN_MENU;
         create_spawn_menu();
     } else {
-        if (active_object_index >= (int)spawned_objects.size()) {
-            active_object_index = spawned_objects.size() - 1;
-        }
+        active_handle = spawned_objects.handle_at(std::min(position, spawned_objects.size() - 1));
         create_object_controls();
     }
     
     update_object_list();
 }
 
+// Push every transform field now, bypassing the per-frame coalescing
 void DebugAlignmentEnhanced::apply_transform_to_object(SpawnedObject& obj) {
-    if (!obj.object) return;
+    obj.transform_dirty |= TRANSFORM_ALL;
+    flush_transform(obj);
+}
+
+void DebugAlignmentEnhanced::mark_transform_dirty(SpawnedObject& obj, uint8_t fields) {
+    obj.transform_dirty |= fields;
+    obj.codegen_dirty = 1;
+    // The index follows the model right away; LVGL catches up at the flush
+    if (fields & (TRANSFORM_X | TRANSFORM_Y | TRANSFORM_WIDTH | TRANSFORM_HEIGHT)) {
+        reindex_object(obj);
+    }
+    if (transform_flush_timer) {
+        lv_timer_resume(transform_flush_timer);
+    } else {
+        flush_transform(obj);
+    }
+}
+
+// Push only the fields that changed since the last flush
+void DebugAlignmentEnhanced::flush_transform(SpawnedObject& obj) {
+    uint8_t dirty = obj.transform_dirty;
+    obj.transform_dirty = 0;
+    if (!obj.object || !dirty) return;
+    HeapMark mark = write_mark();  // First local x/y/size/angle styles allocate
+    
     // Apply position using lv_obj_set_pos to avoid alignment conflicts
-    lv_obj_set_pos(obj.object, obj.transform.x_offset, obj.transform.y_offset);
+    if ((dirty & TRANSFORM_X) && (dirty & TRANSFORM_Y)) {
+        lv_obj_set_pos(obj.object, obj.transform.x_offset, obj.transform.y_offset);
+    } else if (dirty & TRANSFORM_X) {
+        lv_obj_set_x(obj.object, obj.transform.x_offset);
+    } else if (dirty & TRANSFORM_Y) {
+        lv_obj_set_y(obj.object, obj.transform.y_offset);
+    }
 
     // Apply rotation: use semantic rotation for widgets that expose it (Arc),
     // otherwise use style transform angle (LVGL uses 0.1° units).
-    if (obj.type == WidgetType::ARC) {
-        // Arc uses its own semantic rotation API; don't combine with style transform
-        lv_arc_set_rotation(obj.object, obj.transform.rotation);
-        // Ensure style transform angle is cleared so we don't combine them
-        lv_obj_set_style_transform_angle(obj.object, 0, LV_PART_MAIN);
-    } else {
-        // Use style transform angle for generic rotation (degrees * 10)
-        lv_obj_set_style_transform_angle(obj.object, obj.transform.rotation * 10, LV_PART_MAIN);
+    if (dirty & TRANSFORM_ROTATION) {
+        if (obj.type == WidgetType::ARC) {
+            // Arc uses its own semantic rotation API; don't combine with style transform
+            lv_arc_set_rotation(obj.object, obj.transform.rotation);
+            // Ensure style transform angle is cleared so we don't combine them
+            lv_obj_set_style_transform_angle(obj.object, 0, LV_PART_MAIN);
+        } else {
+            // Use style transform angle for generic rotation (degrees * 10)
+            lv_obj_set_style_transform_angle(obj.object, obj.transform.rotation * 10, LV_PART_MAIN);
+        }
+    }
+
+    if ((dirty & TRANSFORM_WIDTH) && (dirty & TRANSFORM_HEIGHT)) {
+        lv_obj_set_size(obj.object, obj.transform.width, obj.transform.height);
+    } else if (dirty & TRANSFORM_WIDTH) {
+        lv_obj_set_width(obj.object, obj.transform.width);
+    } else if (dirty & TRANSFORM_HEIGHT) {
+        lv_obj_set_height(obj.object, obj.transform.height);
     }
+    if (dirty & TRANSFORM_PAD) {
+        lv_obj_set_style_pad_all(obj.object, obj.transform.pad, LV_PART_MAIN);
+    }
+    charge_write(obj, mark);
+}
 
-    // Apply size using width/height helpers so widgets that have single size semantics
-    // (if any) can be handled elsewhere. For now, set both.
-    lv_obj_set_size(obj.object, obj.transform.width, obj.transform.height);
-    lv_obj_set_style_pad_all(obj.object, obj.transform.pad, LV_PART_MAIN);
+// Runs ahead of the display refresh in the same lv_timer_handler() pass, then parks
+// itself until the next mark_transform_dirty()
+void DebugAlignmentEnhanced::flush_transforms_timer_cb(lv_timer_t* timer) {
+    for (auto& obj : spawned_objects) {
+        if (obj.transform_dirty) {
+            flush_transform(obj);
+        }
+    }
+    lv_timer_pause(timer);
 }
 
 void DebugAlignmentEnhanced::apply_properties_to_object(SpawnedObject& obj) {
     if (!obj.object) return;
-    
-    switch (obj.type) {
-        case WidgetType::ARC:
-            lv_arc_set_bg_angles(obj.object, obj.props.start_angle, obj.props.end_angle);
-            lv_obj_set_style_arc_width(obj.object, obj.props.arc_width, LV_PART_INDICATOR);
-            lv_arc_set_value(obj.object, obj.props.value);
-            lv_arc_set_range(obj.object, obj.props.range_min, obj.props.range_max);
-            break;
-            
-        case WidgetType::BAR:
-            lv_bar_set_range(obj.object, obj.props.min_value, obj.props.max_value);
-            lv_bar_set_value(obj.object, obj.props.current_value, LV_ANIM_OFF);
-            break;
-            
-        case WidgetType::SLIDER:
-            lv_slider_set_range(obj.object, obj.props.min_value, obj.props.max_value);
-            lv_slider_set_value(obj.object, obj.props.current_value, LV_ANIM_OFF);
-            break;
-            
-        case WidgetType::BUTTON:
-            // Button state is handled via events
-            break;
-            
-        case WidgetType::SWITCH:
-            if (obj.props.state) {
-                lv_obj_add_state(obj.object, LV_STATE_CHECKED);
-            } else {
-                lv_obj_clear_state(obj.object, LV_STATE_CHECKED);
-            }
-            break;
-            
-        case WidgetType::CHECKBOX:
-            if (obj.props.state) {
-                lv_obj_add_state(obj.object, LV_STATE_CHECKED);
-            } else {
-                lv_obj_clear_state(obj.object, LV_STATE_CHECKED);
-            }
-            break;
-            
-        case WidgetType::LED:
-            if (obj.props.state) {
-                lv_led_on(obj.object);
-            } else {
-                lv_led_off(obj.object);
-            }
-            break;
-            
-        default:
-            break;
+    obj.codegen_dirty = 1;
+    HeapMark mark = write_mark();
+    
+    if (const ArcProps* arc = obj.props_as<ArcProps>()) {
+        lv_arc_set_bg_angles(obj.object, arc->start_angle, arc->end_angle);
+        lv_obj_set_style_arc_width(obj.object, arc->arc_width, LV_PART_INDICATOR);
+        lv_arc_set_value(obj.object, arc->value);
+        lv_arc_set_range(obj.object, arc->range_min, arc->range_max);
+        lv_obj_set_style_arc_width(obj.object, arc->track_width, LV_PART_MAIN);
+        lv_obj_set_style_arc_opa(obj.object, arc->track_visible ? LV_OPA_COVER : LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_arc_rounded(obj.object, arc->rounded_caps, LV_PART_INDICATOR);
+        lv_obj_set_style_pad_all(obj.object, arc->pad, LV_PART_MAIN);
+    } else if (const BarProps* bar = obj.props_as<BarProps>()) {
+        if (obj.type == WidgetType::BAR) {
+            lv_bar_set_mode(obj.object, bar->bar_mode == 0 ? LV_BAR_MODE_NORMAL : LV_BAR_MODE_RANGE);
+            lv_bar_set_range(obj.object, bar->min_value, bar->max_value);
+            lv_bar_set_value(obj.object, bar->current_value, LV_ANIM_OFF);
+        } else {
+            lv_slider_set_range(obj.object, bar->min_value, bar->max_value);
+            lv_slider_set_value(obj.object, bar->current_value, LV_ANIM_OFF);
+        }
+    } else if (const ToggleProps* toggle = obj.props_as<ToggleProps>()) {
+        if (toggle->disabled) {
+            lv_obj_add_state(obj.object, LV_STATE_DISABLED);
+        } else {
+            lv_obj_clear_state(obj.object, LV_STATE_DISABLED);
+        }
+        switch (obj.type) {
+            case WidgetType::SWITCH:
+            case WidgetType::CHECKBOX:
+                if (toggle->state) {
+                    lv_obj_add_state(obj.object, LV_STATE_CHECKED);
+                } else {
+                    lv_obj_clear_state(obj.object, LV_STATE_CHECKED);
+                }
+                break;
+                
+            case WidgetType::LED:
+                if (toggle->state) {
+                    lv_led_on(obj.object);
+                } else {
+                    lv_led_off(obj.object);
+                }
+                break;
+                
+            default:
+                // Button "state" is shown as held down
+                if (toggle->state) {
+                    lv_obj_add_state(obj.object, LV_STATE_PRESSED);
+                } else {
+                    lv_obj_clear_state(obj.object, LV_STATE_PRESSED);
+                }
+                break;
+        }
+    } else if (obj.props_as<CanvasProps>()) {
+        attach_canvas_buffer(obj);
+        paint_canvas(obj);
+    } else if (obj.props_as<ChartProps>()) {
+        apply_chart_props(obj);
+    }
+    charge_write(obj, mark);
+}
+
+// Canvas buffers are sized from the props, not the widget, so the pool can hand a
+// freed buffer of the same footprint to the next canvas
+bool DebugAlignmentEnhanced::attach_canvas_buffer(SpawnedObject& obj) {
+    CanvasProps* canvas = obj.props_as<CanvasProps>();
+    if (!canvas || !obj.object) return false;
+    canvas->canvas_width = std::max(1, std::min(canvas->canvas_width, DEBUG_ALIGNMENT_CANVAS_MAX_SIZE));
+    canvas->canvas_height = std::max(1, std::min(canvas->canvas_height, DEBUG_ALIGNMENT_CANVAS_MAX_SIZE));
+    if (canvas->color_format >= CanvasBufferPool::FORMAT_COUNT) canvas->color_format = 0;
+    if (canvas->test_pattern >= (uint8_t)TestPattern::COUNT) canvas->test_pattern = (uint8_t)TestPattern::GRADIENT;
+    
+    uint32_t width = (uint32_t)canvas->canvas_width;
+    uint32_t height = (uint32_t)canvas->canvas_height;
+    lv_color_format_t format = CanvasBufferPool::format_at(canvas->color_format);
+    if (canvas_pool.matches(obj.object, width, height, format)) return true;
+    
+    void* buffer = canvas_pool.acquire(obj.object, width, height, format);
+    if (!buffer) {
+        DA_LOGE("%s: no memory for a %ux%u %s canvas buffer (%u bytes)", obj.name.c_str(), (unsigned)width,
+                (unsigned)height, CanvasBufferPool::format_name(canvas->color_format),
+                (unsigned)CanvasBufferPool::buffer_size(width, height, format));
+        return false;
+    }
+    lv_canvas_set_buffer(obj.object, buffer, width, height, format);
+    obj.codegen_dirty = 1;
+    
+    CanvasBufferPool::Usage usage = canvas_pool.in_use(canvas->color_format);
+    DA_LOGD("%s: %ux%u %s buffer, %d %s canvases use %u bytes", obj.name.c_str(), (unsigned)width, (unsigned)height,
+            CanvasBufferPool::format_name(canvas->color_format), usage.buffers,
+            CanvasBufferPool::format_name(canvas->color_format), (unsigned)usage.bytes);
+    return true;
+}
+
+// Plain fill or test pattern, written straight into the buffer rather than through
+// the draw pipeline. Sized from the pool's record, which is what the canvas really has
+// if attaching a new buffer failed.
+void DebugAlignmentEnhanced::paint_canvas(const SpawnedObject& obj) {
+    const CanvasProps* canvas = obj.props_as<CanvasProps>();
+    CanvasBufferPool::Buffer buffer = canvas_pool.buffer(obj.object);
+    if (!canvas || !buffer.data) return;
+    
+    PatternTarget target;
+    target.data = static_cast<uint8_t*>(buffer.data);
+    target.width = buffer.width;
+    target.height = buffer.height;
+    target.stride = lv_draw_buf_width_to_stride(buffer.width, buffer.format);
+    target.format = static_cast<PatternFormat>(CanvasBufferPool::format_index(buffer.format));
+    TestPattern pattern = canvas->test_drawing ? static_cast<TestPattern>(canvas->test_pattern) : TestPattern::SOLID;
+    pattern_fill(target, pattern, (uint32_t)canvas->fill_color, obj.serial);
+    lv_obj_invalidate(obj.object);
+}
+
+lv_area_t DebugAlignmentEnhanced::object_box(const SpawnedObject& obj) {
+    lv_area_t box;
+    box.x1 = obj.transform.x_offset;
+    box.y1 = obj.transform.y_offset;
+    box.x2 = obj.transform.x_offset + std::max(1, obj.transform.width) - 1;
+    box.y2 = obj.transform.y_offset + std::max(1, obj.transform.height) - 1;
+    return box;
+}
+
+void DebugAlignmentEnhanced::reindex_object(SpawnedObject& obj) {
+    lv_area_t box = object_box(obj);
+    spatial_index.update(obj.handle, box);
+    edge_index.update(obj.handle, box);
+}
+
+DebugAlignmentEnhanced::ObjectHandle DebugAlignmentEnhanced::pick_object(int32_t x, int32_t y) {
+    std::vector<ObjectHandle> hits;
+    spatial_index.query_point(x, y, hits);
+    
+    // Several boxes can overlap; the one drawn last (highest child index) is on top
+    ObjectHandle top;
+    int32_t top_index = -1;
+    for (ObjectHandle handle : hits) {
+        const SpawnedObject* obj = spawned_objects.get(handle);
+        if (!obj || !obj->object) continue;
+        int32_t index = lv_obj_get_index(obj->object);
+        if (index > top_index) {
+            top_index = index;
+            top = handle;
+        }
     }
+    return top;
 }
 
-DebugAlignmentEnhanced::SpawnedObject* DebugAlignmentEnhanced::get_active_object() {
-    if (active_object_index < 0 || active_object_index >= (int)spawned_objects.size()) {
-        return nullptr;
-    }
-    return &spawned_objects[active_object_index];
+void DebugAlignmentEnhanced::find_objects(const lv_area_t& area, std::vector<ObjectHandle>& out) {
+    spatial_index.query_rect(area, out);
+}
+
+DebugAlignmentEnhanced::ObjectHandle DebugAlignmentEnhanced::find_nearest_edge(int32_t x, int32_t y,
+                                                                               int32_t max_distance, int32_t* distance) {
+    return spatial_index.nearest_edge(x, y, max_distance, ObjectHandle(), distance);
+}
+
+DebugAlignmentEnhanced::SpawnedObject* DebugAlignmentEnhanced::active_object() {
+    return spawned_objects.get(active_handle);
 }
 
 lv_obj_t* DebugAlignmentEnhanced::create_button(lv_obj_t* parent, const char* text, lv_event_cb_t callback, int x, int y, int w, int h) {
     lv_obj_t* btn = lv_btn_create(parent);
     lv_obj_set_size(btn, w, h);
     lv_obj_set_pos(btn, x, y);
-    lv_obj_add_event_cb(btn, callback, LV_EVENT_CLICKED, nullptr);
-    lv_obj_set_style_bg_color(btn, lv_color_hex(0x333333), LV_PART_MAIN);
+    add_traced_event_cb(btn, callback, LV_EVENT_CLICKED, text);
+    apply_style(btn, PanelStyle::PLAIN_BUTTON);
     
     lv_obj_t* label = lv_label_create(btn);
     lv_label_set_text(label, text);
@@ -1189,87 +1499,407 @@ lv_obj_t* DebugAlignmentEnhanced::create_button(lv_obj_t* parent, const char* te
     return btn;
 }
 
-void DebugAlignmentEnhanced::clear_content_area() {
-    if (content_area) {
-        lv_obj_clean(content_area);
-    }
-}
-
-void DebugAlignmentEnhanced::export_object_values(const SpawnedObject& obj) {
-    char export_text[1024];
-    int n = snprintf(export_text, sizeof(export_text),
-        "\n[DEBUG EXPORT] ===== %s VALUES =====\n"
-        "// Transform (common)\n"
-        "#define %s_X_OFFSET     %d\n"
-        "#define %s_Y_OFFSET     %d\n"
-        "#define %s_WIDTH        %d\n"
-        "#define %s_HEIGHT       %d\n"
-        "#define %s_ROTATION     %d\n"
-        "#define %s_PAD          %d\n",
-        obj.name.c_str(),
-        obj.name.c_str(), obj.transform.x_offset,
-        obj.name.c_str(), obj.transform.y_offset,
-        obj.name.c_str(), obj.transform.width,
-        obj.name.c_str(), obj.transform.height,
-        obj.name.c_str(), obj.transform.rotation,
-        obj.name.c_str(), obj.transform.pad);
-    
-    // Add widget-specific properties
-    switch (obj.type) {
-        case WidgetType::ARC:
-            n += snprintf(export_text + n, sizeof(export_text) - n,
-                "// Arc Properties\n"
-                "#define %s_START_ANGLE  %d\n"
-                "#define %s_END_ANGLE    %d\n"
-                "#define %s_ARC_WIDTH    %d\n"
-                "#define %s_TRACK_WIDTH  %d\n"
-                "#define %s_TRACK_VISIBLE %d\n"
-                "#define %s_ROUNDED_CAPS %d\n"
-                "#define %s_VALUE        %d\n"
-                "#define %s_RANGE_MIN    %d\n"
-                "#define %s_RANGE_MAX    %d\n",
-                obj.name.c_str(), obj.props.start_angle,
-                obj.name.c_str(), obj.props.end_angle,
-                obj.name.c_str(), obj.props.arc_width,
-                obj.name.c_str(), obj.props.track_width,
-                obj.name.c_str(), obj.props.track_visible ? 1 : 0,
-                obj.name.c_str(), obj.props.rounded_caps ? 1 : 0,
-                obj.name.c_str(), obj.props.value,
-                obj.name.c_str(), obj.props.range_min,
-                obj.name.c_str(), obj.props.range_max);
-            break;
-            
-        case WidgetType::BAR:
-        case WidgetType::SLIDER:
-            n += snprintf(export_text + n, sizeof(export_text) - n,
-                "// Bar/Slider Properties\n"
-                "#define %s_MIN_VALUE    %d\n"
-                "#define %s_MAX_VALUE    %d\n"
-                "#define %s_CURRENT_VAL  %d\n"
-                "#define %s_HORIZONTAL   %d\n"
-                "#define %s_INDICATOR_W  %d\n",
-                obj.name.c_str(), obj.props.min_value,
-                obj.name.c_str(), obj.props.max_value,
-                obj.name.c_str(), obj.props.current_value,
-                obj.name.c_str(), obj.props.horizontal ? 1 : 0,
-                obj.name.c_str(), obj.props.indicator_width);
-            break;
-            
-        default:
-            // Emit placeholder zeros for unsupported widget-specific fields when exporting
-            n += snprintf(export_text + n, sizeof(export_text) - n,
-                "// No specific properties for this widget type\n"
-                "#define %s_SPECIFIC_1 0\n"
-                "#define %s_SPECIFIC_2 0\n",
-                obj.name.c_str(), obj.name.c_str());
+namespace {
+
+// Export output is gathered here and written in large chunks; one export runs at a time
+char export_buffer[DEBUG_ALIGNMENT_EXPORT_BUFFER];
+
+void export_define(ExportStream& out, const char* id, const char* field, int value) {
+    out.print("#define %s_%-14s %d\n", id, field, value);
+}
+
+}  // namespace
+
+bool DebugAlignmentEnhanced::export_scene(const char* path) {
+    FILE* file = path ? fopen(path, "w") : stdout;
+    if (!file) {
+        DA_LOGE("Could not open %s for export", path);
+        return false;
+    }
+    bool ok;
+    {
+        ExportStream out(file, export_buffer, sizeof(export_buffer));
+        out.print("// [DEBUG EXPORT] %d objects\n\n", spawned_objects.size());
+        export_memory_bill(out);
+        export_render_costs(out);
+        for (const auto& obj : spawned_objects) {
+            export_object_values(obj, out);
+        }
+        ok = out.flush();
+        DA_LOGI("Exported %d objects (%u bytes) to %s", spawned_objects.size(), (unsigned)out.bytes_written(),
+                path ? path : "stdout");
+    }
+    if (path && fclose(file) != 0) ok = false;
+    if (!ok) DA_LOGE("Export to %s failed", path ? path : "stdout");
+    return ok;
+}
+
+void DebugAlignmentEnhanced::export_object_values(const SpawnedObject& obj, ExportStream& out) {
+    char id[EXPORT_IDENTIFIER_SIZE];
+    export_identifier(obj.name.c_str(), id);
+    
+    out.print("// ===== %s =====\n", obj.name.c_str());
+    out.print("// Transform (common)\n");
+    export_define(out, id, "X_OFFSET", obj.transform.x_offset);
+    export_define(out, id, "Y_OFFSET", obj.transform.y_offset);
+    export_define(out, id, "WIDTH", obj.transform.width);
+    export_define(out, id, "HEIGHT", obj.transform.height);
+    export_define(out, id, "ROTATION", obj.transform.rotation);
+    export_define(out, id, "PAD", obj.transform.pad);
+    out.print("// Style\n");
+    export_define(out, id, "BORDER_WIDTH", read_field(obj, FIELD_BORDER_WIDTH));
+    export_define(out, id, "RADIUS", read_field(obj, FIELD_RADIUS));
+    export_define(out, id, "OPA", read_field(obj, FIELD_OPA));
+    export_define(out, id, "HIDDEN", read_field(obj, FIELD_HIDDEN));
+    
+    if (const ArcProps* arc = obj.props_as<ArcProps>()) {
+        out.print("// Arc Properties\n");
+        export_define(out, id, "START_ANGLE", arc->start_angle);
+        export_define(out, id, "END_ANGLE", arc->end_angle);
+        export_define(out, id, "ARC_WIDTH", arc->arc_width);
+        export_define(out, id, "TRACK_WIDTH", arc->track_width);
+        export_define(out, id, "TRACK_VISIBLE", arc->track_visible ? 1 : 0);
+        export_define(out, id, "ROUNDED_CAPS", arc->rounded_caps ? 1 : 0);
+        export_define(out, id, "VALUE", arc->value);
+        export_define(out, id, "RANGE_MIN", arc->range_min);
+        export_define(out, id, "RANGE_MAX", arc->range_max);
+        export_define(out, id, "ARC_PAD", arc->pad);
+    } else if (const BarProps* bar = obj.props_as<BarProps>()) {
+        out.print("// Bar/Slider Properties\n");
+        export_define(out, id, "MIN_VALUE", bar->min_value);
+        export_define(out, id, "MAX_VALUE", bar->max_value);
+        export_define(out, id, "CURRENT_VAL", bar->current_value);
+        export_define(out, id, "HORIZONTAL", bar->horizontal ? 1 : 0);
+        export_define(out, id, "INDICATOR_W", bar->indicator_width);
+        export_define(out, id, "BAR_MODE", bar->bar_mode);
+    } else if (const ToggleProps* toggle = obj.props_as<ToggleProps>()) {
+        out.print("// %s Properties\n", get_widget_type_name(obj.type).c_str());
+        export_define(out, id, "STATE", toggle->state ? 1 : 0);
+        export_define(out, id, "DISABLED", toggle->disabled ? 1 : 0);
+        if (obj.type == WidgetType::LED) {
+            export_define(out, id, "BRIGHTNESS", toggle->brightness);
+            export_define(out, id, "COLOR_INDEX", toggle->color_index);
+        } else if (obj.type == WidgetType::SWITCH) {
+            export_define(out, id, "ANIM_TIME", toggle->anim_time);
+            export_define(out, id, "KNOB_PAD", toggle->knob_pad);
+        } else if (obj.type == WidgetType::BUTTON) {
+            export_define(out, id, "PAD_ALL", toggle->pad_all);
+        }
+    } else if (const CanvasProps* canvas = obj.props_as<CanvasProps>()) {
+        out.print("// Canvas Properties\n");
+        export_define(out, id, "CANVAS_WIDTH", canvas->canvas_width);
+        export_define(out, id, "CANVAS_HEIGHT", canvas->canvas_height);
+        out.print("#define %s_%-14s LV_COLOR_FORMAT_%s\n", id, "COLOR_FORMAT",
+                  CanvasBufferPool::format_name(canvas->color_format));
+        out.print("#define %s_%-14s 0x%06X\n", id, "FILL_COLOR", (unsigned)canvas->fill_color);
+    } else if (const ChartProps* chart = obj.props_as<ChartProps>()) {
+        out.print("// Chart Properties\n");
+        export_define(out, id, "POINTS", chart->chart_points);
+        export_define(out, id, "CHART_TYPE", chart->chart_type);
+        export_define(out, id, "Y_MIN", chart->y_min);
+        export_define(out, id, "Y_MAX", chart->y_max);
+        export_define(out, id, "H_DIV_LINES", chart->h_div_lines);
+        export_define(out, id, "V_DIV_LINES", chart->v_div_lines);
+        export_define(out, id, "UPDATE_MODE", chart->update_mode);
+        export_define(out, id, "SERIES_COUNT", chart->series_count);
+        export_define(out, id, "FEED_RATE", chart->feed_rate);
+        export_define(out, id, "DECIMATE", chart->decimate);
+    } else if (const TableProps* table = obj.props_as<TableProps>()) {
+        out.print("// Table Properties\n");
+        export_define(out, id, "ROWS", table->table_rows);
+        export_define(out, id, "COLS", table->table_cols);
+        export_define(out, id, "COL_WIDTH", table->col_width);
+        export_define(out, id, "CELL_ALIGN", table->cell_align);
+    } else if (const SpinnerProps* spinner = obj.props_as<SpinnerProps>()) {
+        out.print("// Spinner Properties\n");
+        export_define(out, id, "SPEED", spinner->spinner_speed);
+        export_define(out, id, "ARC_LENGTH", spinner->spinner_arc_length);
+    } else if (const SpinboxProps* spinbox = obj.props_as<SpinboxProps>()) {
+        out.print("// Spinbox Properties\n");
+        export_define(out, id, "MIN", spinbox->spinbox_min);
+        export_define(out, id, "MAX", spinbox->spinbox_max);
+        export_define(out, id, "STEP", spinbox->spinbox_step);
+        export_define(out, id, "DIGITS", spinbox->spinbox_digits);
+        export_define(out, id, "SEP_POS", spinbox->spinbox_sep_pos);
+        export_define(out, id, "ROLLOVER", spinbox->spinbox_rollover ? 1 : 0);
+    } else if (const MsgBoxProps* msgbox = obj.props_as<MsgBoxProps>()) {
+        out.print("// Message Box Properties\n");
+        out.print("#define %s_%-14s ", id, "TITLE");
+        out.write_quoted(msgbox->msgbox_title.c_str());
+        out.print("\n#define %s_%-14s ", id, "TEXT");
+        out.write_quoted(msgbox->msgbox_text.c_str());
+        out.write("\n", 1);
+        export_define(out, id, "BUTTON_COUNT", msgbox->msgbox_button_count);
+        export_define(out, id, "MODAL", msgbox->msgbox_modal ? 1 : 0);
+    } else if (const PieProps* pie = obj.props_as<PieProps>()) {
+        out.print("// Pie Chart Properties\n");
+        export_define(out, id, "SEGMENTS", pie->pie_segments);
+        export_define(out, id, "START_ANGLE", pie->pie_start_angle);
+        export_define(out, id, "GAP_ANGLE", pie->pie_gap_angle);
+        export_define(out, id, "DONUT_THICK", pie->pie_donut_thickness);
+        export_define(out, id, "NORMALIZE", pie->pie_normalize ? 1 : 0);
+        export_define(out, id, "ANTIALIAS", pie->pie_antialias ? 1 : 0);
+    }
+    out.write("\n", 1);
+}
+
+int32_t DebugAlignmentEnhanced::read_field(const SpawnedObject& obj, uint8_t field) {
+    switch (field) {
+        case FIELD_X: return obj.transform.x_offset;
+        case FIELD_Y: return obj.transform.y_offset;
+        case FIELD_ROTATION: return obj.transform.rotation;
+        case FIELD_WIDTH: return obj.transform.width;
+        case FIELD_HEIGHT: return obj.transform.height;
+        case FIELD_PAD: return obj.transform.pad;
+        default: break;
+    }
+    // Style handlers change LVGL directly, so these are read back from the object
+    if (!obj.object) return 0;
+    switch (field) {
+        case FIELD_BORDER_WIDTH: return lv_obj_get_style_border_width(obj.object, LV_PART_MAIN);
+        case FIELD_RADIUS: return lv_obj_get_style_radius(obj.object, LV_PART_MAIN);
+        case FIELD_OPA: return lv_obj_get_style_opa(obj.object, LV_PART_MAIN);
+        case FIELD_HIDDEN: return lv_obj_has_flag(obj.object, LV_OBJ_FLAG_HIDDEN) ? 1 : 0;
+        case FIELD_Z_INDEX: return lv_obj_get_index(obj.object);
+        default: return 0;
+    }
+}
+
+void DebugAlignmentEnhanced::take_snapshot(const SpawnedObject& obj, ObjectSnapshot& out) {
+    out.target = obj.handle;
+    for (uint8_t field = 0; field < FIELD_SCALAR_COUNT; field++) {
+        out.values[field] = read_field(obj, field);
+    }
+    out.props_fields = read_props_fields(obj.props, out.props, PROPS_MAX_FIELDS);
+}
+
+// Trampoline for every control button: handler in user_data, deltas into the journal
+void DebugAlignmentEnhanced::journaled_event(lv_event_t* e) {
+    lv_event_cb_t handler = reinterpret_cast<lv_event_cb_t>(lv_event_get_user_data(e));
+    uint64_t begin = DEBUG_ALIGNMENT_TIME_US();
+    run_journaled(handler, e);
+    trace_handler(handler, begin);
+}
+
+void DebugAlignmentEnhanced::run_journaled(lv_event_cb_t handler, lv_event_t* e) {
+    SpawnedObject* obj = active_object();
+    if (!obj) {
+        handler(e);
+        return;
+    }
+    
+    ObjectSnapshot before;
+    take_snapshot(*obj, before);
+    handler(e);
+    
+    // The handler may have deleted the object or switched to another one
+    SpawnedObject* after = spawned_objects.get(before.target);
+    if (!after) return;
+    after->codegen_dirty = 1;  // Z-order handlers change LVGL directly
+    journal.begin_command();
+    // Only transform nudges merge; a flag or a props member always undoes on its own
+    for (uint8_t field = 0; field < FIELD_SCALAR_COUNT; field++) {
+        journal.record(before.target, field, before.values[field], read_field(*after, field), field <= FIELD_PAD);
+    }
+    int32_t props[PROPS_MAX_FIELDS];
+    int count = read_props_fields(after->props, props, PROPS_MAX_FIELDS);
+    for (int i = 0; i < count && i < before.props_fields; i++) {
+        journal.record(before.target, (uint8_t)(FIELD_PROPS + i), before.props[i], props[i]);
+    }
+    journal.end_command();
+}
+
+void DebugAlignmentEnhanced::apply_journal_delta(const JournalDelta& delta, int32_t value) {
+    SpawnedObject* obj = spawned_objects.get(delta.target);
+    if (!obj) return;  // Deleted since; its history is skipped
+    write_field(*obj, delta.field, value);
+}
+
+// Inverse of read_field: transform fields go through the flush, props through
+// apply_properties_to_object(), the rest straight to LVGL. Each path charges its own heap.
+void DebugAlignmentEnhanced::write_field(SpawnedObject& obj, uint8_t field, int32_t value) {
+    obj.codegen_dirty = 1;
+    if (field >= FIELD_PROPS) {
+        if (write_props_field(obj.props, field - FIELD_PROPS, value)) {
+            apply_properties_to_object(obj);
+        }
+        return;
+    }
+    switch (field) {
+        case FIELD_X: obj.transform.x_offset = value; mark_transform_dirty(obj, TRANSFORM_X); return;
+        case FIELD_Y: obj.transform.y_offset = value; mark_transform_dirty(obj, TRANSFORM_Y); return;
+        case FIELD_ROTATION: obj.transform.rotation = value; mark_transform_dirty(obj, TRANSFORM_ROTATION); return;
+        case FIELD_WIDTH: obj.transform.width = value; mark_transform_dirty(obj, TRANSFORM_WIDTH); return;
+        case FIELD_HEIGHT: obj.transform.height = value; mark_transform_dirty(obj, TRANSFORM_HEIGHT); return;
+        case FIELD_PAD: obj.transform.pad = value; mark_transform_dirty(obj, TRANSFORM_PAD); return;
+        default: break;
+    }
+    if (!obj.object) return;
+    HeapMark mark = write_mark();
+    switch (field) {
+        case FIELD_BORDER_WIDTH: lv_obj_set_style_border_width(obj.object, value, LV_PART_MAIN); break;
+        case FIELD_RADIUS: lv_obj_set_style_radius(obj.object, value, LV_PART_MAIN); break;
+        case FIELD_OPA: lv_obj_set_style_opa(obj.object, (lv_opa_t)value, LV_PART_MAIN); break;
+        case FIELD_HIDDEN:
+            if (value) {
+                lv_obj_add_flag(obj.object, LV_OBJ_FLAG_HIDDEN);
+            } else {
+                lv_obj_clear_flag(obj.object, LV_OBJ_FLAG_HIDDEN);
+            }
             break;
+        case FIELD_Z_INDEX: lv_obj_move_to_index(obj.object, value); break;
+        default: break;
+    }
+    charge_write(obj, mark);
+}
+
+bool DebugAlignmentEnhanced::undo() {
+    show_guides(GuideLine(), GuideLine());
+    bool done = journal.undo(apply_journal_delta);
+    DA_LOGD("Undo: %s", done ? "ok" : "nothing to undo");
+    return done;
+}
+
+bool DebugAlignmentEnhanced::redo() {
+    show_guides(GuideLine(), GuideLine());
+    bool done = journal.redo(apply_journal_delta);
+    DA_LOGD("Redo: %s", done ? "ok" : "nothing to redo");
+    return done;
+}
+
+void DebugAlignmentEnhanced::undo_event(lv_event_t*) {
+    undo();
+}
+
+void DebugAlignmentEnhanced::redo_event(lv_event_t*) {
+    redo();
+}
+
+bool DebugAlignmentEnhanced::save_scene(const char* path) {
+    static_assert(FIELD_PAD - FIELD_X + 1 == SceneObject::TRANSFORM_FIELDS, "scene transform fields follow JournalField");
+    static_assert(FIELD_HIDDEN - FIELD_BORDER_WIDTH + 1 == SceneObject::STYLE_FIELDS, "scene style fields follow JournalField");
+    
+    // Back to front, so loading in file order restores the stacking
+    std::vector<const SpawnedObject*> order;
+    order.reserve(spawned_objects.size());
+    for (const auto& obj : spawned_objects) {
+        order.push_back(&obj);
+    }
+    std::sort(order.begin(), order.end(), [](const SpawnedObject* a, const SpawnedObject* b) {
+        return read_field(*a, FIELD_Z_INDEX) < read_field(*b, FIELD_Z_INDEX);
+    });
+    
+    std::vector<uint8_t> bytes;
+    bytes.reserve(16 + order.size() * 96);
+    scene_append_header(bytes, (uint32_t)order.size());
+    for (const SpawnedObject* obj : order) {
+        SceneObject record;
+        record.serial = obj->serial;
+        record.type = (uint8_t)obj->type;
+        for (int i = 0; i < SceneObject::TRANSFORM_FIELDS; i++) {
+            record.transform[i] = read_field(*obj, (uint8_t)(FIELD_X + i));
+        }
+        for (int i = 0; i < SceneObject::STYLE_FIELDS; i++) {
+            record.style[i] = read_field(*obj, (uint8_t)(FIELD_BORDER_WIDTH + i));
+        }
+        scene_append_object(bytes, record, obj->props);
+    }
+    
+    if (!scene_write_file(path, bytes)) {
+        DA_LOGE("Could not write scene %s", path);
+        return false;
+    }
+    DA_LOGI("Saved %d objects to %s (%u bytes)", (int)order.size(), path, (unsigned)bytes.size());
+    return true;
+}
+
+bool DebugAlignmentEnhanced::load_scene(const char* path) {
+    if (!parent_screen) return false;
+    
+    SceneFile file;
+    if (!file.open(path)) {
+        DA_LOGE("Could not read scene %s", path);
+        return false;
+    }
+    SceneReader reader(file.data(), file.size());
+    if (!reader.valid()) {
+        DA_LOGE("%s is not a version %d scene file", path, DEBUG_ALIGNMENT_SCENE_VERSION);
+        return false;
+    }
+    
+    clear_spawned_objects();
+    show_guides(GuideLine(), GuideLine());
+    
+    // One batch: nothing is invalidated per widget and the panel is only rebuilt once.
+    // Layout is left to LVGL's next refresh, so it also runs once for the whole scene.
+    lv_display_t* display = lv_obj_get_display(parent_screen);
+    bool invalidation = lv_display_is_invalidation_enabled(display);
+    lv_display_enable_invalidation(display, false);
+    
+    SceneObject record;
+    int default_props_count = 0;
+    while (reader.next(record)) {
+        if (record.type >= WIDGET_TYPE_COUNT) continue;
+        WidgetType type = (WidgetType)record.type;
+        HeapMark mark = heap_mark();
+        lv_obj_t* widget = create_widget_instance(type, parent_screen);
+        if (!widget) continue;
+        
+        SpawnedObject obj;
+        obj.type = type;
+        obj.object = widget;
+        obj.serial = record.serial;
+        obj.name = get_widget_type_name(type) + " #" + std::to_string(obj.serial);
+        spawn_serial = std::max(spawn_serial, record.serial);
+        obj.transform.x_offset = record.transform[FIELD_X - FIELD_X];
+        obj.transform.y_offset = record.transform[FIELD_Y - FIELD_X];
+        obj.transform.rotation = record.transform[FIELD_ROTATION - FIELD_X];
+        obj.transform.width = record.transform[FIELD_WIDTH - FIELD_X];
+        obj.transform.height = record.transform[FIELD_HEIGHT - FIELD_X];
+        obj.transform.pad = record.transform[FIELD_PAD - FIELD_X];
+        obj.transform_dirty = TRANSFORM_ALL;
+        obj.props = default_props(type);
+        if (!reader.read_props(obj.props)) {
+            default_props_count++;
+        }
+        
+        ObjectHandle handle = spawned_objects.insert(std::move(obj));
+        SpawnedObject& spawned = *spawned_objects.get(handle);
+        spawned.handle = handle;
+        creation_marked = true;
+        flush_transform(spawned);
+        apply_properties_to_object(spawned);
+        // Only values that differ from the theme become local style properties
+        for (int i = 0; i < SceneObject::STYLE_FIELDS; i++) {
+            uint8_t field = (uint8_t)(FIELD_BORDER_WIDTH + i);
+            if (read_field(spawned, field) != record.style[i]) {
+                write_field(spawned, field, record.style[i]);
+            }
+        }
+        reindex_object(spawned);
+        creation_marked = false;
+        spawned.heap_bytes = heap_since(mark);
     }
     
-    n += snprintf(export_text + n, sizeof(export_text) - n, "==============================\n\n");
+    lv_display_enable_invalidation(display, invalidation);
+    lv_obj_invalidate(parent_screen);
     
-    if (n > 0) {
-        fwrite(export_text, 1, (size_t)(n < (int)sizeof(export_text) ? n : (int)sizeof(export_text)), stdout);
+    if (reader.truncated()) {
+        DA_LOGW("Scene %s is truncated; loaded the first %d objects", path, spawned_objects.size());
     }
+    if (default_props_count) {
+        DA_LOGW("%d objects in %s kept default props (stored record is for another type)", default_props_count, path);
+    }
+    
+    if (spawned_objects.empty()) {
+        current_state = UIState::SPAWN_MENU;
+        create_spawn_menu();
+        update_object_list();
+    } else {
+        set_active_object(spawned_objects.handle_at(spawned_objects.size() - 1));
+    }
+    DA_LOGI("Loaded %d objects from %s", spawned_objects.size(), path);
+    return !reader.truncated();
 }
 
 // Event handler implementations
@@ -1299,318 +1929,355 @@ void DebugAlignmentEnhanced::spawn_switch_event(lv_event_t*) { spawn_widget(Widg
 void DebugAlignmentEnhanced::spawn_table_event(lv_event_t*) { spawn_widget(WidgetType::TABLE); }
 void DebugAlignmentEnhanced::spawn_pie_chart_event(lv_event_t*) { spawn_widget(WidgetType::PIE_CHART); }
 
-// Transform control event handlers (using 2px steps as suggested)
-void DebugAlignmentEnhanced::move_left_event(lv_event_t*) {
-    printf("[DEBUG MOVE] LEFT event triggered\n");
-    SpawnedObject* obj = get_active_object();
+// Transform control event handlers (using 2px steps as suggested).
+// Handlers only update the model and mark fields dirty; flush_transforms_timer_cb pushes
+// the result to LVGL once per frame, however many events arrived in between.
+void DebugAlignmentEnhanced::nudge_active_object(int dx, int dy, const char* direction) {
+    SpawnedObject* obj = active_object();
     if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_x = old_x - 2;
-    lv_obj_set_pos(obj->object, new_x, old_y);  // Move LEFT by subtracting from X
-    printf("[DEBUG MOVE] LEFT: %d -> %d\n", old_x, new_x);
-    obj->transform.x_offset = new_x;
+    int old_value = dx ? obj->transform.x_offset : obj->transform.y_offset;
+    obj->transform.x_offset += dx;
+    obj->transform.y_offset += dy;
+    if (guide_snap_enabled) {
+        snap_to_guides(*obj, dx, dy);
+    }
+    int new_value = dx ? obj->transform.x_offset : obj->transform.y_offset;
+    DA_LOGD("MOVE %s: %d -> %d", direction, old_value, new_value);
+    mark_transform_dirty(*obj, dx ? TRANSFORM_X : TRANSFORM_Y);
+}
+
+// Snap the axis being moved onto the nearest line ahead of the object, and show a
+// guide on the other axis only where it already lines up exactly
+void DebugAlignmentEnhanced::snap_to_guides(SpawnedObject& obj, int dx, int dy) {
+    GuideLine next[2];
+    for (int axis = EdgeIndex::AXIS_X; axis <= EdgeIndex::AXIS_Y; axis++) {
+        int motion = axis == EdgeIndex::AXIS_X ? dx : dy;
+        lv_area_t box = object_box(obj);
+        EdgeIndex::Match match = edge_index.snap((EdgeIndex::Axis)axis, box, obj.handle,
+                                                 motion ? GUIDE_SNAP_TOLERANCE : 0, motion);
+        const SpawnedObject* other = match.found ? spawned_objects.get(match.other) : nullptr;
+        if (!other) continue;
+        
+        if (axis == EdgeIndex::AXIS_X) {
+            obj.transform.x_offset += match.delta;
+        } else {
+            obj.transform.y_offset += match.delta;
+        }
+        box = object_box(obj);
+        lv_area_t other_box = object_box(*other);
+        
+        // The guide runs across the other axis, spanning both objects
+        next[axis].visible = true;
+        next[axis].pos = match.line;
+        if (axis == EdgeIndex::AXIS_X) {
+            next[axis].from = std::min(box.y1, other_box.y1);
+            next[axis].to = std::max(box.y2, other_box.y2);
+        } else {
+            next[axis].from = std::min(box.x1, other_box.x1);
+            next[axis].to = std::max(box.x2, other_box.x2);
+        }
+    }
+    show_guides(next[EdgeIndex::AXIS_X], next[EdgeIndex::AXIS_Y]);
+}
+
+void DebugAlignmentEnhanced::show_guides(const GuideLine& vertical, const GuideLine& horizontal) {
+    const GuideLine* next[2] = {&vertical, &horizontal};
+    for (int axis = EdgeIndex::AXIS_X; axis <= EdgeIndex::AXIS_Y; axis++) {
+        GuideLine& current = guides[axis];
+        if (current.visible == next[axis]->visible && current.pos == next[axis]->pos &&
+            current.from == next[axis]->from && current.to == next[axis]->to) {
+            continue;
+        }
+        // Only the strips under the old and new line are redrawn
+        invalidate_guide((EdgeIndex::Axis)axis, current);
+        current = *next[axis];
+        invalidate_guide((EdgeIndex::Axis)axis, current);
+    }
+}
+
+void DebugAlignmentEnhanced::invalidate_guide(EdgeIndex::Axis axis, const GuideLine& guide) {
+    if (!guide.visible || !parent_screen) return;
+    lv_area_t screen_coords;
+    lv_obj_get_coords(parent_screen, &screen_coords);
+    lv_area_t area;
+    if (axis == EdgeIndex::AXIS_X) {
+        area.x1 = screen_coords.x1 + guide.pos - 1;
+        area.x2 = screen_coords.x1 + guide.pos + 1;
+        area.y1 = screen_coords.y1 + guide.from;
+        area.y2 = screen_coords.y1 + guide.to;
+    } else {
+        area.x1 = screen_coords.x1 + guide.from;
+        area.x2 = screen_coords.x1 + guide.to;
+        area.y1 = screen_coords.y1 + guide.pos - 1;
+        area.y2 = screen_coords.y1 + guide.pos + 1;
+    }
+    lv_obj_invalidate_area(parent_screen, &area);
+}
+
+// DRAW_POST on the screen runs after its children, so guides sit on top of the widgets
+void DebugAlignmentEnhanced::guides_draw_event(lv_event_t* e) {
+    if (!guides[EdgeIndex::AXIS_X].visible && !guides[EdgeIndex::AXIS_Y].visible) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t screen_coords;
+    lv_obj_get_coords(parent_screen, &screen_coords);
+    
+    lv_draw_line_dsc_t line;
+    lv_draw_line_dsc_init(&line);
+    line.color = lv_color_hex(0xFF4081);
+    line.width = 1;
+    line.opa = LV_OPA_COVER;
+    for (int axis = EdgeIndex::AXIS_X; axis <= EdgeIndex::AXIS_Y; axis++) {
+        const GuideLine& guide = guides[axis];
+        if (!guide.visible) continue;
+        if (axis == EdgeIndex::AXIS_X) {
+            line.p1.x = line.p2.x = screen_coords.x1 + guide.pos;
+            line.p1.y = screen_coords.y1 + guide.from;
+            line.p2.y = screen_coords.y1 + guide.to;
+        } else {
+            line.p1.y = line.p2.y = screen_coords.y1 + guide.pos;
+            line.p1.x = screen_coords.x1 + guide.from;
+            line.p2.x = screen_coords.x1 + guide.to;
+        }
+        lv_draw_line(layer, &line);
+    }
+}
+
+void DebugAlignmentEnhanced::guide_snap_toggle_event(lv_event_t*) {
+    guide_snap_enabled = !guide_snap_enabled;
+    if (!guide_snap_enabled) {
+        show_guides(GuideLine(), GuideLine());
+    }
+    DA_LOGI("Guide snapping %s", guide_snap_enabled ? "on" : "off");
+}
+
+void DebugAlignmentEnhanced::move_left_event(lv_event_t*) {
+    nudge_active_object(-2, 0, "LEFT");
 }
 
 void DebugAlignmentEnhanced::move_right_event(lv_event_t*) {
-    printf("[DEBUG MOVE] RIGHT event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_x = old_x + 2;
-    lv_obj_set_pos(obj->object, new_x, old_y);  // Move RIGHT by adding to X
-    printf("[DEBUG MOVE] RIGHT: %d -> %d\n", old_x, new_x);
-    obj->transform.x_offset = new_x;
+    nudge_active_object(2, 0, "RIGHT");
 }
 
 void DebugAlignmentEnhanced::move_up_event(lv_event_t*) {
-    printf("[DEBUG MOVE] UP event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_y = old_y - 2;
-    lv_obj_set_pos(obj->object, old_x, new_y);  // Move UP by subtracting from Y
-    printf("[DEBUG MOVE] UP: %d -> %d\n", old_y, new_y);
-    obj->transform.y_offset = new_y;
+    nudge_active_object(0, -2, "UP");
 }
 
 void DebugAlignmentEnhanced::move_down_event(lv_event_t*) {
-    printf("[DEBUG MOVE] DOWN event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_y = old_y + 2;
-    lv_obj_set_pos(obj->object, old_x, new_y);  // Move DOWN by adding to Y
-    printf("[DEBUG MOVE] DOWN: %d -> %d\n", old_y, new_y);
-    obj->transform.y_offset = new_y;
+    nudge_active_object(0, 2, "DOWN");
 }
 
 void DebugAlignmentEnhanced::move_left_fast_event(lv_event_t*) {
-    printf("[DEBUG MOVE] LEFT FAST event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_x = old_x - 15;
-    lv_obj_set_pos(obj->object, new_x, old_y);  // Fast LEFT movement
-    printf("[DEBUG MOVE] LEFT FAST: %d -> %d\n", old_x, new_x);
-    obj->transform.x_offset = new_x;
+    nudge_active_object(-15, 0, "LEFT FAST");
 }
 
 void DebugAlignmentEnhanced::move_right_fast_event(lv_event_t*) {
-    printf("[DEBUG MOVE] RIGHT FAST event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_x = old_x + 15;
-    lv_obj_set_pos(obj->object, new_x, old_y);  // Fast RIGHT movement
-    printf("[DEBUG MOVE] RIGHT FAST: %d -> %d\n", old_x, new_x);
-    obj->transform.x_offset = new_x;
+    nudge_active_object(15, 0, "RIGHT FAST");
 }
 
 void DebugAlignmentEnhanced::move_up_fast_event(lv_event_t*) {
-    printf("[DEBUG MOVE] UP FAST event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_y = old_y - 15;
-    lv_obj_set_pos(obj->object, old_x, new_y);  // Fast UP movement
-    printf("[DEBUG MOVE] UP FAST: %d -> %d\n", old_y, new_y);
-    obj->transform.y_offset = new_y;
+    nudge_active_object(0, -15, "UP FAST");
 }
 
 void DebugAlignmentEnhanced::move_down_fast_event(lv_event_t*) {
-    printf("[DEBUG MOVE] DOWN FAST event triggered\n");
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    int old_x = lv_obj_get_x(obj->object);
-    int old_y = lv_obj_get_y(obj->object);
-    int new_y = old_y + 15;
-    lv_obj_set_pos(obj->object, old_x, new_y);  // Fast DOWN movement
-    printf("[DEBUG MOVE] DOWN FAST: %d -> %d\n", old_y, new_y);
-    obj->transform.y_offset = new_y;
+    nudge_active_object(0, 15, "DOWN FAST");
 }
 
 void DebugAlignmentEnhanced::rotate_cw_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     // rotation stored in degrees; add 5 degrees per step
     obj->transform.rotation += 5;
-    apply_transform_to_object(*obj);
+    mark_transform_dirty(*obj, TRANSFORM_ROTATION);
 }
 
 void DebugAlignmentEnhanced::rotate_ccw_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     obj->transform.rotation -= 5;
-    apply_transform_to_object(*obj);
+    mark_transform_dirty(*obj, TRANSFORM_ROTATION);
 }
 
 void DebugAlignmentEnhanced::resize_wider_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     
     if (obj->type == WidgetType::ARC) {
         // For Arc widgets, increase both width and height together (size)
         obj->transform.width += 10;
         obj->transform.height += 10;
-        lv_obj_set_size(obj->object, obj->transform.width, obj->transform.height);
+        mark_transform_dirty(*obj, TRANSFORM_WIDTH | TRANSFORM_HEIGHT);
     } else {
         // For other widgets, only increase width
         obj->transform.width += 10;
-        lv_obj_set_width(obj->object, obj->transform.width);
+        mark_transform_dirty(*obj, TRANSFORM_WIDTH);
     }
 }
 
 void DebugAlignmentEnhanced::resize_narrower_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     
     if (obj->type == WidgetType::ARC) {
         // For Arc widgets, decrease both width and height together (size)
         obj->transform.width = std::max(10, obj->transform.width - 10);
         obj->transform.height = std::max(10, obj->transform.height - 10);
-        lv_obj_set_size(obj->object, obj->transform.width, obj->transform.height);
+        mark_transform_dirty(*obj, TRANSFORM_WIDTH | TRANSFORM_HEIGHT);
     } else {
         // For other widgets, only decrease width
         obj->transform.width = std::max(10, obj->transform.width - 10);
-        lv_obj_set_width(obj->object, obj->transform.width);
+        mark_transform_dirty(*obj, TRANSFORM_WIDTH);
     }
 }
 
 void DebugAlignmentEnhanced::resize_taller_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     obj->transform.height += 10;
-    lv_obj_set_height(obj->object, obj->transform.height);
+    mark_transform_dirty(*obj, TRANSFORM_HEIGHT);
 }
 
 void DebugAlignmentEnhanced::resize_shorter_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     obj->transform.height = std::max(10, obj->transform.height - 10);
-    lv_obj_set_height(obj->object, obj->transform.height);
+    mark_transform_dirty(*obj, TRANSFORM_HEIGHT);
 }
 
 void DebugAlignmentEnhanced::bring_to_front_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     lv_obj_move_foreground(obj->object);
 }
 
 void DebugAlignmentEnhanced::send_to_back_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj) return;
     lv_obj_move_background(obj->object);
 }
 
 // Snap helpers
 void DebugAlignmentEnhanced::snap_left_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     // Small margin
     const int margin = 5;
     obj->transform.x_offset = margin;
-    lv_obj_set_x(obj->object, obj->transform.x_offset);
+    mark_transform_dirty(*obj, TRANSFORM_X);
 }
 
 void DebugAlignmentEnhanced::snap_right_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     lv_coord_t pw = lv_obj_get_width(parent);
-    lv_coord_t ow = lv_obj_get_width(obj->object);
+    lv_coord_t ow = obj->transform.width;
     const int margin = 5;
     obj->transform.x_offset = pw - ow - margin;
-    lv_obj_set_x(obj->object, obj->transform.x_offset);
+    mark_transform_dirty(*obj, TRANSFORM_X);
 }
 
 void DebugAlignmentEnhanced::snap_top_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     const int margin = 5;
     obj->transform.y_offset = margin;
-    lv_obj_set_y(obj->object, obj->transform.y_offset);
+    mark_transform_dirty(*obj, TRANSFORM_Y);
 }
 
 void DebugAlignmentEnhanced::snap_bottom_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     lv_coord_t ph = lv_obj_get_height(parent);
-    lv_coord_t oh = lv_obj_get_height(obj->object);
+    lv_coord_t oh = obj->transform.height;
     const int margin = 5;
     obj->transform.y_offset = ph - oh - margin;
-    lv_obj_set_y(obj->object, obj->transform.y_offset);
+    mark_transform_dirty(*obj, TRANSFORM_Y);
 }
 
 void DebugAlignmentEnhanced::snap_center_h_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     lv_coord_t pw = lv_obj_get_width(parent);
-    lv_coord_t ow = lv_obj_get_width(obj->object);
+    lv_coord_t ow = obj->transform.width;
     obj->transform.x_offset = (pw - ow) / 2;
-    apply_transform_to_object(*obj);
+    mark_transform_dirty(*obj, TRANSFORM_X);
 }
 
 void DebugAlignmentEnhanced::snap_center_v_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     lv_coord_t ph = lv_obj_get_height(parent);
-    lv_coord_t oh = lv_obj_get_height(obj->object);
+    lv_coord_t oh = obj->transform.height;
     obj->transform.y_offset = (ph - oh) / 2;
-    apply_transform_to_object(*obj);
+    mark_transform_dirty(*obj, TRANSFORM_Y);
 }
 
 void DebugAlignmentEnhanced::snap_center_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
     lv_obj_t* parent = lv_obj_get_parent(obj->object);
     if (!parent) parent = parent_screen;
     lv_coord_t pw = lv_obj_get_width(parent);
     lv_coord_t ph = lv_obj_get_height(parent);
-    lv_coord_t ow = lv_obj_get_width(obj->object);
-    lv_coord_t oh = lv_obj_get_height(obj->object);
+    lv_coord_t ow = obj->transform.width;
+    lv_coord_t oh = obj->transform.height;
     obj->transform.x_offset = (pw - ow) / 2;
     obj->transform.y_offset = (ph - oh) / 2;
-    apply_transform_to_object(*obj);
+    mark_transform_dirty(*obj, TRANSFORM_X | TRANSFORM_Y);
 }
 
 void DebugAlignmentEnhanced::snap_to_grid_event(lv_event_t* e) {
     // Toggle grid snapping for active object; if enabling immediately snap the object
     grid_snap_enabled = !grid_snap_enabled;
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (obj && obj->object && grid_snap_enabled) {
         // Snap current position to grid
         int gx = (obj->transform.x_offset + grid_size/2) / grid_size * grid_size;
         int gy = (obj->transform.y_offset + grid_size/2) / grid_size * grid_size;
         obj->transform.x_offset = gx;
         obj->transform.y_offset = gy;
-        apply_transform_to_object(*obj);
-    }
-    // Update persistent grid label if present
-    if (grid_label_ptr) {
-        char gtxt[32];
-        snprintf(gtxt, sizeof(gtxt), "Size: %d%s", grid_size, grid_snap_enabled ? " (On)" : " (Off)");
-        lv_label_set_text(grid_label_ptr, gtxt);
-    }
-    // Update the caller button label if we have an event
-    if (e) {
-        lv_obj_t* target = (lv_obj_t*)lv_event_get_target(e);
-        if (target) {
-            lv_obj_t* lbl = lv_obj_get_child(target, 0);
-            if (lbl) lv_label_set_text(lbl, grid_snap_enabled ? "Grid:On" : "Grid:Off");
-        }
+        mark_transform_dirty(*obj, TRANSFORM_X | TRANSFORM_Y);
     }
+    // Update the bound panel's grid size and toggle labels
+    refresh_grid_labels();
+    (void)e;
 }
 
 void DebugAlignmentEnhanced::grid_size_plus_event(lv_event_t* e) {
     grid_size = std::min(200, grid_size + 5);
     // If grid snapping is active, optionally snap current object
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (obj && obj->object && grid_snap_enabled) {
         int gx = (obj->transform.x_offset + grid_size/2) / grid_size * grid_size;
         int gy = (obj->transform.y_offset + grid_size/2) / grid_size * grid_size;
         obj->transform.x_offset = gx;
         obj->transform.y_offset = gy;
-        apply_transform_to_object(*obj);
-    }
-    if (grid_label_ptr) {
-        char gtxt[32];
-        snprintf(gtxt, sizeof(gtxt), "Size: %d%s", grid_size, grid_snap_enabled ? " (On)" : " (Off)");
-        lv_label_set_text(grid_label_ptr, gtxt);
+        mark_transform_dirty(*obj, TRANSFORM_X | TRANSFORM_Y);
     }
+    refresh_grid_labels();
     (void)e;
 }
 
 void DebugAlignmentEnhanced::grid_size_minus_event(lv_event_t* e) {
     grid_size = std::max(1, grid_size - 5);
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (obj && obj->object && grid_snap_enabled) {
         int gx = (obj->transform.x_offset + grid_size/2) / grid_size * grid_size;
         int gy = (obj->transform.y_offset + grid_size/2) / grid_size * grid_size;
         obj->transform.x_offset = gx;
         obj->transform.y_offset = gy;
-        apply_transform_to_object(*obj);
-    }
-    if (grid_label_ptr) {
-        char gtxt[32];
-        snprintf(gtxt, sizeof(gtxt), "Size: %d%s", grid_size, grid_snap_enabled ? " (On)" : " (Off)");
-        lv_label_set_text(grid_label_ptr, gtxt);
+        mark_transform_dirty(*obj, TRANSFORM_X | TRANSFORM_Y);
     }
+    refresh_grid_labels();
     (void)e;
 }
 
@@ -1643,347 +2310,405 @@ void DebugAlignmentEnhanced::toggle_section_event(lv_event_t* e) {
 }
 
 void DebugAlignmentEnhanced::export_values_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    export_object_values(*obj);
+    export_scene(nullptr);
 }
 
 // Global style and visibility controls
 void DebugAlignmentEnhanced::toggle_visibility_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj) return;
-    
-    if (lv_obj_has_flag(obj->object, LV_OBJ_FLAG_HIDDEN)) {
-        lv_obj_clear_flag(obj->object, LV_OBJ_FLAG_HIDDEN);
-    } else {
-        lv_obj_add_flag(obj->object, LV_OBJ_FLAG_HIDDEN);
-    }
+    SpawnedObject* obj = active_object();
+    if (!obj || !obj->object) return;
+    write_field(*obj, FIELD_HIDDEN, read_field(*obj, FIELD_HIDDEN) ? 0 : 1);
 }
 
+// Style edits go through write_field() so the heap a new local style takes is charged
 void DebugAlignmentEnhanced::border_width_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_coord_t current_border = lv_obj_get_style_border_width(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_border_width(obj->object, current_border + 1, LV_PART_MAIN);
+    write_field(*obj, FIELD_BORDER_WIDTH, read_field(*obj, FIELD_BORDER_WIDTH) + 1);
 }
 
 void DebugAlignmentEnhanced::border_width_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_coord_t current_border = lv_obj_get_style_border_width(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_border_width(obj->object, std::max(0, (int)current_border - 1), LV_PART_MAIN);
+    write_field(*obj, FIELD_BORDER_WIDTH, std::max(0, (int)read_field(*obj, FIELD_BORDER_WIDTH) - 1));
 }
 
 void DebugAlignmentEnhanced::radius_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_coord_t current_radius = lv_obj_get_style_radius(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_radius(obj->object, current_radius + 2, LV_PART_MAIN);
+    write_field(*obj, FIELD_RADIUS, read_field(*obj, FIELD_RADIUS) + 2);
 }
 
 void DebugAlignmentEnhanced::radius_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_coord_t current_radius = lv_obj_get_style_radius(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_radius(obj->object, std::max(0, (int)current_radius - 2), LV_PART_MAIN);
+    write_field(*obj, FIELD_RADIUS, std::max(0, (int)read_field(*obj, FIELD_RADIUS) - 2));
 }
 
 void DebugAlignmentEnhanced::opacity_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_opa_t current_opa = lv_obj_get_style_opa(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_opa(obj->object, std::min(255, (int)current_opa + 25), LV_PART_MAIN);
+    write_field(*obj, FIELD_OPA, std::min(255, (int)read_field(*obj, FIELD_OPA) + 25));
 }
 
 void DebugAlignmentEnhanced::opacity_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
+    SpawnedObject* obj = active_object();
     if (!obj || !obj->object) return;
-    
-    lv_opa_t current_opa = lv_obj_get_style_opa(obj->object, LV_PART_MAIN);
-    lv_obj_set_style_opa(obj->object, std::max(25, (int)current_opa - 25), LV_PART_MAIN);
+    write_field(*obj, FIELD_OPA, std::max(25, (int)read_field(*obj, FIELD_OPA) - 25));
 }
 
 // Arc-specific property controls
 void DebugAlignmentEnhanced::arc_start_angle_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.start_angle += 5;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->start_angle += 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_start_angle_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.start_angle -= 5;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->start_angle -= 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_end_angle_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.end_angle += 5;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->end_angle += 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_end_angle_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.end_angle -= 5;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->end_angle -= 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_width_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.arc_width += 2;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->arc_width += 2;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_width_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.arc_width = std::max(1, obj->props.arc_width - 2);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->arc_width = std::max(1, arc->arc_width - 2);
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_toggle_caps_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.rounded_caps = !obj->props.rounded_caps;
-    if (obj->props.rounded_caps) {
-        lv_obj_set_style_arc_rounded(obj->object, true, LV_PART_INDICATOR);
-    } else {
-        lv_obj_set_style_arc_rounded(obj->object, false, LV_PART_INDICATOR);
-    }
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->rounded_caps = !arc->rounded_caps;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_value_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.value = std::min(obj->props.range_max, obj->props.value + 5);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->value = std::min(arc->range_max, arc->value + 5);
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_value_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.value = std::max(obj->props.range_min, obj->props.value - 5);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->value = std::max(arc->range_min, arc->value - 5);
     apply_properties_to_object(*obj);
 }
 
 // Bar/Slider property controls
 void DebugAlignmentEnhanced::bar_min_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.min_value += 5;
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->min_value += 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_min_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.min_value -= 5;
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->min_value -= 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_max_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.max_value += 5;
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->max_value += 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_max_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.max_value -= 5;
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->max_value -= 5;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_value_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.current_value = std::min(obj->props.max_value, obj->props.current_value + 5);
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->current_value = std::min(bar->max_value, bar->current_value + 5);
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_value_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
-    obj->props.current_value = std::max(obj->props.min_value, obj->props.current_value - 5);
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->current_value = std::max(bar->min_value, bar->current_value - 5);
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::bar_toggle_orientation_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || (obj->type != WidgetType::BAR && obj->type != WidgetType::SLIDER)) return;
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
     
-    obj->props.horizontal = !obj->props.horizontal;
+    bar->horizontal = !bar->horizontal;
     
     // Swap width and height for orientation change
     int temp = obj->transform.width;
     obj->transform.width = obj->transform.height;
     obj->transform.height = temp;
     
-    lv_obj_set_size(obj->object, obj->transform.width, obj->transform.height);
+    mark_transform_dirty(*obj, TRANSFORM_WIDTH | TRANSFORM_HEIGHT);
 }
 
 // State toggle controls
 void DebugAlignmentEnhanced::button_toggle_state_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::BUTTON) return;
-    obj->props.state = !obj->props.state;
-    if (obj->props.state) {
-        lv_obj_add_state(obj->object, LV_STATE_PRESSED);
-    } else {
-        lv_obj_clear_state(obj->object, LV_STATE_PRESSED);
-    }
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::BUTTON ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->state = !toggle->state;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::switch_toggle_state_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::SWITCH) return;
-    obj->props.state = !obj->props.state;
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::SWITCH ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->state = !toggle->state;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::checkbox_toggle_state_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::CHECKBOX) return;
-    obj->props.state = !obj->props.state;
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::CHECKBOX ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->state = !toggle->state;
     apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::button_toggle_disabled_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::BUTTON) return;
-    obj->props.disabled = !obj->props.disabled;
-    if (obj->props.disabled) {
-        lv_obj_add_state(obj->object, LV_STATE_DISABLED);
-    } else {
-        lv_obj_clear_state(obj->object, LV_STATE_DISABLED);
-    }
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::BUTTON ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->disabled = !toggle->disabled;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::checkbox_toggle_disabled_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::CHECKBOX) return;
-    obj->props.disabled = !obj->props.disabled;
-    if (obj->props.disabled) {
-        lv_obj_add_state(obj->object, LV_STATE_DISABLED);
-    } else {
-        lv_obj_clear_state(obj->object, LV_STATE_DISABLED);
-    }
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::CHECKBOX ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->disabled = !toggle->disabled;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::led_toggle_state_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::LED) return;
-    obj->props.state = !obj->props.state;
+    SpawnedObject* obj = active_object();
+    ToggleProps* toggle = obj && obj->type == WidgetType::LED ? obj->props_as<ToggleProps>() : nullptr;
+    if (!toggle) return;
+    toggle->state = !toggle->state;
     apply_properties_to_object(*obj);
 }
 
+// Canvas controls
+void DebugAlignmentEnhanced::canvas_format_cycle_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+    if (!canvas) return;
+    uint8_t previous = canvas->color_format;
+    canvas->color_format = (uint8_t)((canvas->color_format + 1) % CanvasBufferPool::FORMAT_COUNT);
+    if (!attach_canvas_buffer(*obj)) canvas->color_format = previous;
+    paint_canvas(*obj);
+}
+
+// Plain fill, stepping through a few panel colors
+void DebugAlignmentEnhanced::canvas_fill_color_event(lv_event_t*) {
+    static const int colors[] = {0x333333, 0x3498DB, 0x27AE60, 0xE74C3C, 0xF39C12, 0xFFFFFF, 0x000000};
+    const int count = (int)(sizeof(colors) / sizeof(colors[0]));
+    SpawnedObject* obj = active_object();
+    CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+    if (!canvas) return;
+    int next = 0;
+    for (int i = 0; i < count; i++) {
+        if (colors[i] == canvas->fill_color) next = (i + 1) % count;
+    }
+    canvas->fill_color = colors[next];
+    canvas->test_drawing = false;
+    paint_canvas(*obj);
+}
+
+void DebugAlignmentEnhanced::canvas_clear_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+    if (!canvas) return;
+    canvas->test_drawing = false;
+    paint_canvas(*obj);
+}
+
+// First press shows the current test pattern, later ones step to the next
+void DebugAlignmentEnhanced::canvas_draw_test_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+    if (!canvas) return;
+    if (canvas->test_drawing) {
+        int next = canvas->test_pattern + 1;
+        canvas->test_pattern = (uint8_t)(next < (int)TestPattern::COUNT ? next : (int)TestPattern::GRADIENT);
+    }
+    canvas->test_drawing = true;
+    paint_canvas(*obj);
+    DA_LOGD("%s: %s test pattern (%s)", obj->name.c_str(), pattern_name((TestPattern)canvas->test_pattern),
+            pattern_fill_isa());
+}
+
+// Resize the buffer to the object's current transform size
+void DebugAlignmentEnhanced::canvas_recreate_event(lv_event_t*) {
+    SpawnedObject* obj = active_object();
+    CanvasProps* canvas = obj ? obj->props_as<CanvasProps>() : nullptr;
+    if (!canvas) return;
+    CanvasProps previous = *canvas;
+    canvas->canvas_width = obj->transform.width;
+    canvas->canvas_height = obj->transform.height;
+    if (!attach_canvas_buffer(*obj)) *canvas = previous;
+    paint_canvas(*obj);
+}
+
 // Additional Arc controls
 void DebugAlignmentEnhanced::arc_range_min_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.range_min += 5;
-    if (obj->props.range_min >= obj->props.range_max) {
-        obj->props.range_min = obj->props.range_max - 1;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->range_min += 5;
+    if (arc->range_min >= arc->range_max) {
+        arc->range_min = arc->range_max - 1;
     }
-    lv_arc_set_range(obj->object, obj->props.range_min, obj->props.range_max);
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_range_min_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.range_min -= 5;
-    lv_arc_set_range(obj->object, obj->props.range_min, obj->props.range_max);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->range_min -= 5;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_range_max_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.range_max += 5;
-    lv_arc_set_range(obj->object, obj->props.range_min, obj->props.range_max);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->range_max += 5;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_range_max_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.range_max -= 5;
-    if (obj->props.range_max <= obj->props.range_min) {
-        obj->props.range_max = obj->props.range_min + 1;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->range_max -= 5;
+    if (arc->range_max <= arc->range_min) {
+        arc->range_max = arc->range_min + 1;
     }
-    lv_arc_set_range(obj->object, obj->props.range_min, obj->props.range_max);
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_rotation_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
     obj->transform.rotation += 5;  // Fix: store in transform, not props
-    obj->props.rotation = obj->transform.rotation;  // Keep props in sync
-    lv_arc_set_rotation(obj->object, obj->transform.rotation);
+    arc->rotation = obj->transform.rotation;  // Keep props in sync
+    mark_transform_dirty(*obj, TRANSFORM_ROTATION);
 }
 
 void DebugAlignmentEnhanced::arc_rotation_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
     obj->transform.rotation -= 5;  // Fix: store in transform, not props
-    obj->props.rotation = obj->transform.rotation;  // Keep props in sync
-    lv_arc_set_rotation(obj->object, obj->transform.rotation);
+    arc->rotation = obj->transform.rotation;  // Keep props in sync
+    mark_transform_dirty(*obj, TRANSFORM_ROTATION);
 }
 
 void DebugAlignmentEnhanced::arc_track_width_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.track_width += 2;
-    lv_obj_set_style_arc_width(obj->object, obj->props.track_width, LV_PART_MAIN);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->track_width += 2;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_track_width_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.track_width = std::max(1, obj->props.track_width - 2);
-    lv_obj_set_style_arc_width(obj->object, obj->props.track_width, LV_PART_MAIN);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->track_width = std::max(1, arc->track_width - 2);
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_toggle_track_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.track_visible = !obj->props.track_visible;
-    if (obj->props.track_visible) {
-        lv_obj_set_style_arc_opa(obj->object, LV_OPA_COVER, LV_PART_MAIN);
-    } else {
-        lv_obj_set_style_arc_opa(obj->object, LV_OPA_TRANSP, LV_PART_MAIN);
-    }
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->track_visible = !arc->track_visible;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_pad_plus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.pad += 2;
-    lv_obj_set_style_pad_all(obj->object, obj->props.pad, LV_PART_MAIN);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->pad += 2;
+    apply_properties_to_object(*obj);
 }
 
 void DebugAlignmentEnhanced::arc_pad_minus_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::ARC) return;
-    obj->props.pad = std::max(0, obj->props.pad - 2);
-    lv_obj_set_style_pad_all(obj->object, obj->props.pad, LV_PART_MAIN);
+    SpawnedObject* obj = active_object();
+    ArcProps* arc = obj ? obj->props_as<ArcProps>() : nullptr;
+    if (!arc) return;
+    arc->pad = std::max(0, arc->pad - 2);
+    apply_properties_to_object(*obj);
 }
 
 // Additional Bar controls
 void DebugAlignmentEnhanced::bar_toggle_mode_event(lv_event_t*) {
-    SpawnedObject* obj = get_active_object();
-    if (!obj || obj->type != WidgetType::BAR) return;
-    obj->props.bar_mode = (obj->props.bar_mode == 0) ? 1 : 0;
-    lv_bar_set_mode(obj->object, obj->props.bar_mode == 0 ? LV_BAR_MODE_NORMAL : LV_BAR_MODE_RANGE);
+    SpawnedObject* obj = active_object();
+    BarProps* bar = obj && obj->type == WidgetType::BAR ? obj->props_as<BarProps>() : nullptr;
+    if (!bar) return;
+    bar->bar_mode = (bar->bar_mode == 0) ? 1 : 0;
+    apply_properties_to_object(*obj);
 }
 
 #endif
@@ -7,6 +7,19 @@ Purpose: Enhanced debug alignment overlay with widget spawning and management
 #pragma once
 
 #include "lvgl/lvgl.h"
+#include "debug_alignment_canvas_pool.hpp"
+#include "debug_alignment_decimate.hpp"
+#include "debug_alignment_export.hpp"
+#include "debug_alignment_guides.hpp"
+#include "debug_alignment_heatmap.hpp"
+#include "debug_alignment_journal.hpp"
+#include "debug_alignment_patterns.hpp"
+#include "debug_alignment_props.hpp"
+#include "debug_alignment_ring.hpp"
+#include "debug_alignment_scene.hpp"
+#include "debug_alignment_slot_map.hpp"
+#include "debug_alignment_spatial.hpp"
+#include "debug_alignment_trace.hpp"
 #include <functional>
 #include <vector>
 #include <string>
@@ -14,10 +27,19 @@ Purpose: Enhanced debug alignment overlay with widget spawning and management
 // Enable/disable debug alignment overlay globally
 #define ENABLE_DEBUG_ALIGNMENT 1
 
+// Start in the low-overhead render profile (opaque fills, no shadows or gradients).
+// Can still be switched at runtime with set_render_profile().
+#ifndef DEBUG_ALIGNMENT_LOW_OVERHEAD
+#define DEBUG_ALIGNMENT_LOW_OVERHEAD 0
+#endif
+
 class DebugAlignmentEnhanced {
+    // Headless benchmark harness (bench/debug_alignment_bench.cpp) drives private paths
+    friend class DebugAlignmentBench;
+
 public:
     // Widget types we can spawn
-    enum class WidgetType {
+    enum class WidgetType : uint8_t {
         ARC,
         BAR,
         BUTTON,
@@ -34,99 +56,14 @@ public:
         PIE_CHART
     };
 
-    // Spawned object data
+    // Stable reference to a spawned object; stops resolving once the object is deleted
+    using ObjectHandle = SlotHandle;
+
+    // Spawned object data (fields ordered largest first to avoid padding)
     struct SpawnedObject {
-        WidgetType type;
         lv_obj_t* object;
         std::string name;
-        int index;
-        
-        // Widget-specific properties
-        struct {
-            // Arc properties
-            int start_angle = 0;
-            int end_angle = 280;
-            int arc_width = 22;
-            int track_width = 5;
-            bool track_visible = true;
-            bool rounded_caps = false;
-            int value = 50;
-            int range_min = 0;
-            int range_max = 100;
-            int rotation = 0;
-            int pad = 0;
-            
-            // Bar/Slider properties
-            int min_value = 0;
-            int max_value = 100;
-            int current_value = 50;
-            bool horizontal = true;
-            int indicator_width = 20;
-            int bar_mode = 0; // 0=normal, 1=range
-            
-            // Button/Switch/Checkbox/LED properties
-            bool state = false;
-            bool checked = false;
-            bool disabled = false;
-            std::string label_text = "Label";
-            int pad_all = 5;
-            int brightness = 255; // LED
-            int color_index = 0;  // LED color cycling
-            
-            // Canvas properties
-            int canvas_width = 200;
-            int canvas_height = 150;
-            int fill_color = 0x000000;
-            bool test_drawing = false;
-            
-            // Chart properties
-            int chart_points = 10;
-            int chart_type = 0; // 0=line, 1=bar, 2=scatter
-            int y_min = 0;
-            int y_max = 100;
-            int h_div_lines = 5;
-            int v_div_lines = 5;
-            int update_mode = 0; // 0=circular, 1=shift
-            int series_count = 1;
-            
-            // Table properties
-            int table_rows = 3;
-            int table_cols = 3;
-            int selected_row = 0;
-            int selected_col = 0;
-            int col_width = 80;
-            int cell_align = 0; // 0=left, 1=center, 2=right
-            
-            // Spinner properties
-            int spinner_speed = 1000;
-            int spinner_arc_length = 60;
-            
-            // Spinbox properties
-            int spinbox_min = 0;
-            int spinbox_max = 100;
-            int spinbox_step = 1;
-            bool spinbox_rollover = false;
-            int spinbox_digits = 4;
-            int spinbox_sep_pos = 2;
-            
-            // Switch properties
-            int anim_time = 200;
-            int knob_pad = 2;
-            
-            // Message Box properties
-            std::string msgbox_title = "Title";
-            std::string msgbox_text = "Message";
-            bool msgbox_modal = false;
-            int msgbox_button_count = 2;
-            
-            // Pie chart properties
-            int pie_segments = 4;
-            bool pie_normalize = true;
-            int pie_start_angle = 0;
-            int pie_gap_angle = 2;
-            int pie_donut_thickness = 0; // 0 = full pie
-            bool pie_antialias = true;
-        } props;
+        WidgetProps props;  // Record matching type; read it through props_as<>()
         
         // Common transform properties
         struct {
@@ -137,6 +74,16 @@ public:
             int height = 200;
             int pad = 0;
         } transform;
+        ObjectHandle handle;  // This object's own handle (keys the spatial and edge indexes)
+        uint32_t serial;  // Spawn number shown in the name; never reused
+        int32_t heap_bytes = 0;  // LVGL heap taken at creation and by later edits, canvas buffer excluded
+        WidgetType type;
+        uint8_t transform_dirty = 0;  // TRANSFORM_* fields not yet pushed to LVGL
+        uint8_t codegen_dirty = 1;    // Generated code fragment is out of date
+        
+        // Widget-specific record, or nullptr if this object's type uses a different one
+        template <typename P> P* props_as() { return std::get_if<P>(&props); }
+        template <typename P> const P* props_as() const { return std::get_if<P>(&props); }
     };
 
     // Current UI state
@@ -145,13 +92,31 @@ public:
         OBJECT_CONTROLS  // Show controls for active object
     };
 
+    // How the panel chrome is drawn
+    enum class RenderProfile {
+        RICH,          // Translucent glass panels, gradients and shadows
+        LOW_OVERHEAD   // Opaque fills only; cheap to blend on software renderers
+    };
+
+    // What one object costs to draw: its area is redrawn with the object shown and then
+    // hidden, and the difference is the object (children, layers and blending included)
+    struct RenderCost {
+        ObjectHandle handle;
+        uint32_t shown_us = 0;   // Fastest redraw of the object's area with it shown
+        uint32_t hidden_us = 0;  // Same area with it hidden, i.e. what lies behind it
+        uint32_t cost_us() const { return shown_us > hidden_us ? shown_us - hidden_us : 0; }
+    };
+
 private:
     static lv_obj_t* debug_panel;
     static lv_obj_t* toggle_button;
     static bool panel_visible;
     static UIState current_state;
-    static std::vector<SpawnedObject> spawned_objects;
-    static int active_object_index;
+    static SlotMap<SpawnedObject> spawned_objects;  // List order is the dense order
+    static ObjectHandle active_handle;
+    static uint32_t spawn_serial;
+    static SpatialGrid spatial_index;  // Boxes from transform, kept current by mark_transform_dirty
+    static EdgeIndex edge_index;       // Same boxes as edge/center lines, for guide snapping
     static lv_obj_t* parent_screen;
     
     // UI components
@@ -159,12 +124,201 @@ private:
     static lv_obj_t* object_list_area;
     static lv_obj_t* controls_area;
     
+    // Control panel tabs, filled on first show
+    enum class ControlTab {
+        TRANSFORM,
+        STYLE,
+        PROPERTIES,
+        COUNT
+    };
+    
+    // Control panels are built once per WidgetType and re-bound to the active object on selection
+    struct ControlPanel {
+        lv_obj_t* root = nullptr;              // Retained container under content_area
+        lv_obj_t* title_label = nullptr;       // Shows the bound object's name
+        lv_obj_t* tab_view = nullptr;
+        lv_obj_t* tabs[(int)ControlTab::COUNT] = {};
+        uint8_t built_tabs = 0;                // Bit per ControlTab whose content exists
+        lv_obj_t* widget_controls = nullptr;   // Properties tab content
+        lv_obj_t* grid_label = nullptr;        // Grid size readout in the Style tab
+        lv_obj_t* grid_toggle_label = nullptr; // Label of the Grid:On/Off button
+    };
+    static constexpr int WIDGET_TYPE_COUNT = 14;
+    static ControlPanel control_panels[WIDGET_TYPE_COUNT];
+    static lv_obj_t* spawn_menu_root;
+    
+    // Object list strip: a fixed pool of chips re-bound to whichever objects are scrolled into view
+    struct ObjectChip {
+        lv_obj_t* chip = nullptr;
+        lv_obj_t* label = nullptr;
+        int bound_index = -1;         // List position, -1 when unused
+        ObjectHandle bound_handle;    // Object shown at that position; what a tap selects
+        std::string shown_name;       // Last name pushed to the label
+        bool shown_active = false;    // Last styling applied
+    };
+    static constexpr int OBJECT_CHIP_PITCH = 110;  // Chip width plus gap
+    static constexpr int OBJECT_CHIP_POOL = 6;     // Enough to cover the visible strip while scrolling
+    static ObjectChip object_chips[OBJECT_CHIP_POOL];
+    static lv_obj_t* object_strip;
+    static lv_obj_t* object_strip_spacer;
+    static lv_obj_t* object_list_empty_label;
+    
+    // Frame timing strip under the object strip (debug_alignment_perf.cpp). Display
+    // render and flush events push one sample per frame into a ring while the panel is
+    // open; a throttled timer drains it into the history the sparkline is drawn from.
+    struct FrameSample {
+        uint32_t tick = 0;       // lv_tick_get() when rendering finished
+        uint32_t render_us = 0;  // Rendering, time in flush_cb excluded
+        uint32_t flush_us = 0;   // Time in flush_cb
+        uint32_t pixels = 0;     // Pixels flushed, i.e. the invalidated area redrawn
+    };
+    struct FrameTiming {
+        bool rendering = false;
+        uint64_t render_begin_us = 0;
+        uint64_t flush_begin_us = 0;
+        uint32_t flush_us = 0;
+        uint32_t pixels = 0;
+    };
+    static constexpr int PERF_HISTORY = 60;  // Frames in the sparkline
+    static SpscRing<FrameSample, 128> frame_samples;
+    static FrameSample frame_history[PERF_HISTORY];
+    static uint32_t frame_history_count;  // Frames ever taken in; the newest is at (count - 1) % PERF_HISTORY
+    static FrameTiming frame_timing;
+    static lv_display_t* perf_display;  // Display the hooks are on, nullptr while unhooked
+    static lv_timer_t* perf_timer;
+    static lv_obj_t* perf_strip;
+    static lv_obj_t* perf_label;
+    static uint32_t perf_last_update;
+    static bool perf_self_refresh;  // The strip redrew last time, so one new frame is its own
+    static void create_perf_strip(lv_obj_t* parent);
+    static void start_perf_hooks();
+    static void stop_perf_hooks();
+    static void perf_display_event(lv_event_t* e);
+    static void perf_timer_cb(lv_timer_t* timer);
+    static void perf_strip_draw_event(lv_event_t* e);
+    
+    // Redraw heatmap (debug_alignment_heatmap_overlay.cpp): flushed areas summed into a coarse grid
+    // and drawn over parent_screen in its DRAW_POST. Stays on with the panel closed.
+    static RedrawHeatmap redraw_heatmap;
+    static lv_display_t* heatmap_display;  // Display the hooks are on, nullptr while off
+    static lv_timer_t* heatmap_timer;
+    static lv_obj_t* heatmap_button_label;
+    static uint32_t heatmap_shown_frames;  // frames() when the overlay was last refreshed
+    static bool heatmap_refresh_pending;   // The overlay invalidated the screen...
+    static bool heatmap_self_frame;        // ...and this is the frame that redraws it
+    static void heatmap_toggle_event(lv_event_t* e);
+    static void heatmap_display_event(lv_event_t* e);
+    static void heatmap_timer_cb(lv_timer_t* timer);
+    static void heatmap_draw_event(lv_event_t* e);
+    
+    // Event handler tracing (debug_alignment_trace_hooks.cpp). Every input callback is registered
+    // through a trampoline that carries the handler in user_data: journaled_event for
+    // control buttons, traced_event for the rest. Each call and the display refresh after
+    // it go into event_trace.
+    static EventTrace event_trace;
+    static lv_display_t* trace_display;  // Display the refresh hooks are on
+    static lv_obj_t* trace_label;        // Summary in the spawn menu
+    static void traced_event(lv_event_t* e);
+    static void add_traced_event_cb(lv_obj_t* obj, lv_event_cb_t handler, lv_event_code_t code, const char* name);
+    static void trace_handler(lv_event_cb_t handler, uint64_t begin_us);
+    static void start_trace_hooks();
+    static void stop_trace_hooks();
+    static void trace_display_event(lv_event_t* e);
+    static void trace_save_event(lv_event_t* e);
+    static void refresh_trace_report();
+    
+    // Render cost ranking (debug_alignment_cost.cpp)
+    static std::vector<RenderCost> render_costs;  // Costliest first; a snapshot, not kept current
+    static lv_obj_t* render_cost_label;           // Table in the spawn menu
+    static uint32_t time_object_redraw(lv_display_t* display, lv_obj_t* object, bool hidden);
+    static void render_cost_event(lv_event_t* e);
+    static void refresh_render_cost_table();
+    static void export_render_costs(ExportStream& out);
+    
+    // LVGL heap accounting (debug_alignment_memory.cpp). Allocator snapshots around widget
+    // creation and around each object-side write (props apply, style field, transform
+    // flush) are charged to the object, so panel text a handler sets is not. Canvas
+    // buffers are counted from the pool instead, since a parked buffer can be reused
+    // without touching the heap.
+    struct HeapMark {
+        int64_t used = 0;
+        int64_t canvas = 0;
+        bool taken = false;
+    };
+    static lv_obj_t* memory_label;  // Report in the spawn menu
+    static bool creation_marked;    // A scene load's per-object mark already covers writes
+    static HeapMark heap_mark();
+    static int32_t heap_since(const HeapMark& mark);
+    static HeapMark write_mark();
+    static void charge_write(SpawnedObject& obj, const HeapMark& mark);
+    static size_t canvas_bytes(const SpawnedObject& obj);
+    static void memory_refresh_event(lv_event_t* e);
+    static void refresh_memory_report();
+    static void export_memory_bill(ExportStream& out);
+    
     // Create UI components
+    static void build_debug_panel();
     static void create_spawn_menu();
     static void create_object_controls();
     static void create_object_list();
     static void update_object_list();
+    static void sync_object_chips();
+    static void bind_object_chip(ObjectChip& slot, int index);
+    static void style_object_chip(lv_obj_t* chip, bool active);
     static void update_controls_for_active_object();
+    static lv_obj_t* create_content_root();
+    static void show_content_root(lv_obj_t* root);
+    static void build_control_panel(ControlPanel& panel, WidgetType type);
+    static void bind_control_panel(ControlPanel& panel, const SpawnedObject& obj);
+    static void build_control_tab(ControlPanel& panel, ControlTab tab);
+    static void control_tab_changed_event(lv_event_t* e);
+    
+    // Shared style registry (debug_alignment_styles.cpp): panel chrome is defined once
+    // and attached with lv_obj_add_style instead of per-object local styles
+    enum class PanelStyle {
+        TOGGLE_BUTTON,
+        PANEL,
+        LIST_AREA,
+        CONTENT_AREA,
+        TRANSPARENT,
+        CONTROL_GRID,
+        HEADER,
+        ACTION_ROW,
+        TAB_VIEW,
+        TAB_BAR,
+        TAB_PAGE,
+        SECTION,
+        BUTTON,
+        PRESSED,
+        CARD,
+        CARD_PRESSED,
+        NEW_BUTTON,
+        CHIP,
+        CHIP_ACTIVE,
+        CHIP_INACTIVE,
+        PLAIN_BUTTON,
+        TEXT_BUTTON,
+        TEXT_BUTTON_LARGE,
+        TEXT_TITLE,
+        TEXT_HEADING,
+        TEXT_SECTION,
+        TEXT_SUBTITLE,
+        TEXT_SMALL,
+        TEXT_VALUE,
+        TEXT_MUTED,
+        TEXT_CARD_DESC,
+        COUNT
+    };
+    static lv_style_t panel_styles[(int)PanelStyle::COUNT];
+    static bool panel_styles_ready;
+    static lv_style_t& style_of(PanelStyle style);
+    static RenderProfile render_profile;
+    static void init_styles();
+    static void define_panel_styles();
+    static void reset_styles();
+    static void apply_style(lv_obj_t* obj, PanelStyle style, lv_style_selector_t selector = LV_PART_MAIN);
+    static void remove_style(lv_obj_t* obj, PanelStyle style, lv_style_selector_t selector = LV_PART_MAIN);
+    static void apply_color_style(lv_obj_t* obj, uint32_t color);
     
     // Modern UI helpers
     static lv_obj_t* create_modern_button(lv_obj_t* parent, const char* text, lv_event_cb_t callback, uint32_t color, int width, int height);
@@ -172,20 +326,43 @@ private:
     static void create_style_controls(lv_obj_t* parent);
     static void create_widget_specific_controls(lv_obj_t* parent);
     static lv_obj_t* create_control_section(lv_obj_t* parent, const char* title, int x, int y);
+    static lv_obj_t* create_control_grid(lv_obj_t* parent);
+    static lv_obj_t* create_styled_label(lv_obj_t* parent, const char* text, PanelStyle style);
     
     // Widget spawning
     static void spawn_widget(WidgetType type);
     static lv_obj_t* create_widget_instance(WidgetType type, lv_obj_t* parent);
     static std::string get_widget_type_name(WidgetType type);
+    static WidgetProps default_props(WidgetType type);
     
     // Object management
-    static void set_active_object(int index);
+    static void set_active_object(ObjectHandle handle);
+    static SpawnedObject* active_object();
+    static void clear_spawned_objects();
     static void delete_active_object();
     static void apply_transform_to_object(SpawnedObject& obj);
+    
+    // Per-frame transform coalescing: handlers mark fields, one timer pushes them
+    static constexpr uint8_t TRANSFORM_X = 1 << 0;
+    static constexpr uint8_t TRANSFORM_Y = 1 << 1;
+    static constexpr uint8_t TRANSFORM_WIDTH = 1 << 2;
+    static constexpr uint8_t TRANSFORM_HEIGHT = 1 << 3;
+    static constexpr uint8_t TRANSFORM_ROTATION = 1 << 4;
+    static constexpr uint8_t TRANSFORM_PAD = 1 << 5;
+    static constexpr uint8_t TRANSFORM_ALL = 0x3F;
+    static lv_timer_t* transform_flush_timer;
+    static void mark_transform_dirty(SpawnedObject& obj, uint8_t fields);
+    static lv_area_t object_box(const SpawnedObject& obj);
+    static void reindex_object(SpawnedObject& obj);
+    static void flush_transform(SpawnedObject& obj);
+    static void flush_transforms_timer_cb(lv_timer_t* timer);
+    static void nudge_active_object(int dx, int dy, const char* direction);
     static void apply_properties_to_object(SpawnedObject& obj);
     
     // Event handlers
     static void toggle_panel_event(lv_event_t* e);
+    static void object_strip_scroll_event(lv_event_t* e);
+    static void object_chip_clicked_event(lv_event_t* e);
     static void back_to_menu_event(lv_event_t* e);
     static void spawn_arc_event(lv_event_t* e);
     static void spawn_bar_event(lv_event_t* e);
@@ -225,6 +402,21 @@ private:
     static void snap_to_grid_event(lv_event_t* e);
     static void grid_size_plus_event(lv_event_t* e);
     static void grid_size_minus_event(lv_event_t* e);
+    // Guide snapping: nudges snap the active object's edges/centers to other objects'
+    static constexpr int GUIDE_SNAP_TOLERANCE = 6;
+    struct GuideLine {
+        bool visible = false;
+        int32_t pos = 0;   // x of a vertical guide, y of a horizontal one
+        int32_t from = 0;  // Extent along the line, covering both aligned objects
+        int32_t to = 0;
+    };
+    static bool guide_snap_enabled;
+    static GuideLine guides[2];  // Indexed by EdgeIndex::Axis
+    static void snap_to_guides(SpawnedObject& obj, int dx, int dy);
+    static void show_guides(const GuideLine& vertical, const GuideLine& horizontal);
+    static void invalidate_guide(EdgeIndex::Axis axis, const GuideLine& guide);
+    static void guides_draw_event(lv_event_t* e);
+    static void guide_snap_toggle_event(lv_event_t* e);
     static void rotate_cw_event(lv_event_t* e);
     static void rotate_ccw_event(lv_event_t* e);
     static void resize_wider_event(lv_event_t* e);
@@ -236,6 +428,30 @@ private:
     static void delete_active_event(lv_event_t* e);
     static void export_values_event(lv_event_t* e);
     
+    // Undo/redo. Control buttons run their handler through journaled_event, which
+    // snapshots the active object, runs the handler and records what changed.
+    enum JournalField : uint8_t {
+        FIELD_X, FIELD_Y, FIELD_ROTATION, FIELD_WIDTH, FIELD_HEIGHT, FIELD_PAD,  // transform
+        FIELD_BORDER_WIDTH, FIELD_RADIUS, FIELD_OPA, FIELD_HIDDEN, FIELD_Z_INDEX,  // read from LVGL
+        FIELD_SCALAR_COUNT,
+        FIELD_PROPS = 32,        // + member index in the record's PropsFields table
+    };
+    struct ObjectSnapshot {
+        ObjectHandle target;
+        int32_t values[FIELD_SCALAR_COUNT];
+        int32_t props[PROPS_MAX_FIELDS];
+        int props_fields;
+    };
+    static UndoJournal journal;
+    static void journaled_event(lv_event_t* e);
+    static void run_journaled(lv_event_cb_t handler, lv_event_t* e);
+    static void take_snapshot(const SpawnedObject& obj, ObjectSnapshot& out);
+    static int32_t read_field(const SpawnedObject& obj, uint8_t field);
+    static void write_field(SpawnedObject& obj, uint8_t field, int32_t value);
+    static void apply_journal_delta(const JournalDelta& delta, int32_t value);
+    static void undo_event(lv_event_t* e);
+    static void redo_event(lv_event_t* e);
+    
     // Global style and visibility controls
     static void toggle_visibility_event(lv_event_t* e);
     static void border_width_plus_event(lv_event_t* e);
@@ -291,6 +507,11 @@ private:
     static void canvas_clear_event(lv_event_t* e);
     static void canvas_draw_test_event(lv_event_t* e);
     static void canvas_recreate_event(lv_event_t* e);
+    static void canvas_format_cycle_event(lv_event_t* e);
+    static CanvasBufferPool canvas_pool;
+    // Point a canvas at a pool buffer matching its props (no-op if it already does)
+    static bool attach_canvas_buffer(SpawnedObject& obj);
+    static void paint_canvas(const SpawnedObject& obj);
     
     // Chart controls
     static void chart_toggle_type_event(lv_event_t* e);
@@ -305,6 +526,51 @@ private:
     static void chart_div_lines_plus_event(lv_event_t* e);
     static void chart_div_lines_minus_event(lv_event_t* e);
     static void chart_toggle_update_mode_event(lv_event_t* e);
+    static void chart_feed_rate_plus_event(lv_event_t* e);
+    static void chart_feed_rate_minus_event(lv_event_t* e);
+    static void chart_toggle_decimation_event(lv_event_t* e);
+    static void apply_chart_props(SpawnedObject& obj);
+    
+    // Synthetic data feeder (debug_alignment_chart.cpp): one timer streams samples into
+    // every series of each chart whose feed_rate is non-zero
+    struct ChartFeed {
+        ObjectHandle handle;
+        lv_obj_t* chart = nullptr;
+        uint64_t next_sample = 0;    // Absolute index of the next sample
+        uint32_t last_tick = 0;
+        uint32_t owed = 0;           // rate * elapsed ms left over below one sample (x1000)
+        // Current readout window
+        uint32_t window_start = 0;
+        uint32_t window_points = 0;
+        uint64_t draw_begin_us = 0;
+        uint64_t window_draw_us = 0;
+        uint32_t window_draws = 0;
+        // Last completed window
+        uint32_t points_per_sec = 0;
+        uint32_t draw_us = 0;        // Average chart draw pass
+        uint32_t draw_permille = 0;  // Share of wall time spent drawing the chart
+        // Min/max decimation: one envelope per series, each column two chart points
+        struct SeriesEnvelope {
+            MinMaxDecimator decimator;
+            bool shown = false;  // Open column already written, so it is rewritten in place
+        };
+        uint32_t per_column = 0;  // Samples per column, 0 = every sample goes to the chart
+        bool resized = false;     // Width now needs another column count; re-applied next tick
+        std::vector<SeriesEnvelope> envelopes;
+    };
+    static std::vector<ChartFeed> chart_feeds;
+    static lv_timer_t* chart_feed_timer;
+    static lv_obj_t* chart_readout_label;  // Properties tab readout; cleared when deleted
+    static ChartFeed* find_chart_feed(ObjectHandle handle);
+    static void start_chart_feed(SpawnedObject& obj);
+    static void stop_chart_feeds();
+    static void feed_chart(SpawnedObject& obj, ChartFeed& feed, uint32_t now);
+    static void sync_chart_decimation(SpawnedObject& obj, ChartFeed& feed, uint32_t per_column);
+    static void chart_size_changed_event(lv_event_t* e);
+    static void chart_feed_timer_cb(lv_timer_t* timer);
+    static void chart_draw_timing_event(lv_event_t* e);
+    static void chart_readout_deleted_event(lv_event_t* e);
+    static void refresh_chart_readout();
     
     // Checkbox controls
     static void checkbox_toggle_state_event(lv_event_t* e);
@@ -373,16 +639,19 @@ private:
     
     // Helper functions
     static lv_obj_t* create_button(lv_obj_t* parent, const char* text, lv_event_cb_t callback, int x, int y, int w = 100, int h = 40);
-    static void clear_content_area();
-    static void export_object_values(const SpawnedObject& obj);
+    static void refresh_grid_labels();
+    static void export_object_values(const SpawnedObject& obj, ExportStream& out);
+    static std::vector<std::string> codegen_fragments;  // Generated code per object, by handle slot
+    static void generate_fragment(const SpawnedObject& obj, std::string& out);
     // Section toggle helper
     static void toggle_section_event(lv_event_t* e);
 
     // Widget-specific controls parent (used so we can create a nested container)
     static lv_obj_t* widget_controls_parent;
 
-    // Persistent grid label pointer so grid toggles update in-place
+    // Grid labels of the bound control panel so grid toggles update in-place
     static lv_obj_t* grid_label_ptr;
+    static lv_obj_t* grid_toggle_label_ptr;
 
 public:
     // Initialize the debug alignment system on any screen
@@ -397,6 +666,71 @@ public:
     // Get current spawned objects count
     static int get_spawned_count() { return spawned_objects.size(); }
     
-    // Get active object (if any)
-    static SpawnedObject* get_active_object();
+    // Handle of the active object (invalid if none)
+    static ObjectHandle get_active_object() { return active_handle; }
+    
+    // Handle of the object at a position in the object list (invalid if out of range)
+    static ObjectHandle get_object_at(int position) { return spawned_objects.handle_at(position); }
+    
+    // Object behind a handle, or nullptr once it has been deleted
+    static SpawnedObject* get_object(ObjectHandle handle) { return spawned_objects.get(handle); }
+    
+    // Spatial queries on the unrotated transform boxes (screen coordinates), answered
+    // from a grid index rather than a scan of every object:
+    // topmost object under a point (invalid if none)
+    static ObjectHandle pick_object(int32_t x, int32_t y);
+    // every object overlapping an area
+    static void find_objects(const lv_area_t& area, std::vector<ObjectHandle>& out);
+    // object whose edge is nearest to a point, within max_distance pixels
+    static ObjectHandle find_nearest_edge(int32_t x, int32_t y, int32_t max_distance, int32_t* distance = nullptr);
+    
+    // Step back/forward through control edits (same as the Undo/Redo buttons)
+    static bool undo();
+    static bool redo();
+    // Bytes of edit history to keep (DEBUG_ALIGNMENT_UNDO_BUDGET by default)
+    static void set_undo_budget(size_t bytes) { journal.set_budget(bytes); }
+    
+    // Binary scene files (see debug_alignment_scene.hpp): every object's type,
+    // transform, props and Style tab overrides. Loading replaces the current objects.
+    static bool save_scene(const char* path);
+    static bool load_scene(const char* path);
+    
+    // Every object's values as #define constants with C identifier names, streamed to
+    // a file (or stdout when path is nullptr). The Export button calls this.
+    static bool export_scene(const char* path = nullptr);
+    
+    // Write LVGL creation code for the whole scene: one create_<name>() per object and
+    // debug_alignment_create_scene(parent). Only objects edited since the last run are
+    // regenerated, and the file is left untouched when its bytes would not change.
+    static bool generate_code(const char* path);
+    
+    // Canvas buffer RAM: live buffers per CanvasBufferPool format index, and freed
+    // buffers kept for reuse
+    static CanvasBufferPool::Usage get_canvas_memory(int format_index) { return canvas_pool.in_use(format_index); }
+    static CanvasBufferPool::Usage get_canvas_spare() { return canvas_pool.spare(); }
+    
+    // Redraw heatmap over the screen: on starts a fresh accumulation, off logs the
+    // hottest cell and removes the overlay
+    static void set_redraw_heatmap(bool enabled);
+    static bool get_redraw_heatmap() { return heatmap_display != nullptr; }
+    
+    // Time every visible object's redraw and rank them, costliest first (same as the
+    // Measure button). Blocks for DEBUG_ALIGNMENT_COST_SAMPLES refreshes per object and state.
+    static void measure_render_costs();
+    static const std::vector<RenderCost>& get_render_costs() { return render_costs; }
+    
+    // RAM the scene would take in production code: each object's LVGL heap plus its
+    // canvas buffer, against DEBUG_ALIGNMENT_RAM_BUDGET. Needs LVGL's builtin allocator;
+    // with another one lv_mem_monitor() reports nothing and only canvas buffers count.
+    static size_t get_scene_ram();
+    static int32_t get_object_ram(ObjectHandle handle);
+    
+    // Write the buffered handler calls and refreshes as Chrome trace-event JSON (the
+    // Save button writes DEBUG_ALIGNMENT_TRACE_PATH); open it in chrome://tracing or Perfetto
+    static bool export_trace(const char* path);
+    static void clear_trace() { event_trace.clear(); }
+    
+    // Switch the panel look; restyles an open panel in place
+    static void set_render_profile(RenderProfile profile);
+    static RenderProfile get_render_profile() { return render_profile; }
 };
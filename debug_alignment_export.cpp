@@ -0,0 +1,106 @@
+/*
+File:   debug_alignment_export.cpp
+Author: Will Jenkins
+Purpose: Buffered text stream and identifier helpers for exporting spawned objects
+*/
+
+#include "debug_alignment_export.hpp"
+#include <cstdarg>
+#include <cstring>
+
+ExportStream::ExportStream(FILE* out, char* buffer, size_t size) : out_(out), buffer_(buffer), size_(size) {}
+
+void ExportStream::print(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list retry;
+    va_copy(retry, args);
+    int n = vsnprintf(buffer_ + used_, size_ - used_, fmt, args);
+    va_end(args);
+    if (n >= 0 && (size_t)n >= size_ - used_) {
+        // Did not fit: make room and format again
+        flush();
+        n = vsnprintf(buffer_, size_, fmt, retry);
+        if (n >= 0 && (size_t)n >= size_) {
+            // Longer than the whole buffer: let stdio stream it
+            va_end(retry);
+            va_start(retry, fmt);
+            if (vfprintf(out_, fmt, retry) < 0) ok_ = false;
+            written_ += (size_t)n;
+            n = 0;
+        }
+    }
+    va_end(retry);
+    if (n < 0) {
+        ok_ = false;
+        return;
+    }
+    used_ += (size_t)n;
+}
+
+void ExportStream::write(const char* data, size_t length) {
+    if (length > size_ - used_) {
+        flush();
+        if (length > size_) {
+            if (fwrite(data, 1, length, out_) != length) ok_ = false;
+            written_ += length;
+            return;
+        }
+    }
+    memcpy(buffer_ + used_, data, length);
+    used_ += length;
+}
+
+void ExportStream::write_quoted(const char* s) {
+    write("\"", 1);
+    const char* run = s;
+    for (; *s; s++) {
+        const char* escape = nullptr;
+        switch (*s) {
+            case '"': escape = "\\\""; break;
+            case '\\': escape = "\\\\"; break;
+            case '\n': escape = "\\n"; break;
+            case '\t': escape = "\\t"; break;
+            case '\r': escape = "\\r"; break;
+            default: break;
+        }
+        if (!escape) continue;
+        write(run, (size_t)(s - run));
+        write(escape, 2);
+        run = s + 1;
+    }
+    write(run, (size_t)(s - run));
+    write("\"", 1);
+}
+
+bool ExportStream::flush() {
+    if (used_ > 0) {
+        if (fwrite(buffer_, 1, used_, out_) != used_) ok_ = false;
+        written_ += used_;
+        used_ = 0;
+    }
+    if (fflush(out_) != 0) ok_ = false;
+    return ok_;
+}
+
+char* export_identifier(const char* name, char* out, size_t size) {
+    size_t n = 0;
+    bool pending_underscore = false;
+    for (const char* p = name; *p && n + 2 < size; p++) {
+        char c = *p;
+        bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (!alnum) {
+            pending_underscore = n > 0;  // Leading separators are dropped
+            continue;
+        }
+        if (n == 0 && c >= '0' && c <= '9') out[n++] = '_';
+        if (pending_underscore) {
+            out[n++] = '_';
+            pending_underscore = false;
+        }
+        out[n++] = (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+    }
+    if (n == 0) out[n++] = '_';
+    out[n] = '\0';
+    return out;
+}
@@ -0,0 +1,55 @@
+/*
+File:   debug_alignment_export.hpp
+Author: Will Jenkins
+Purpose: Buffered text stream and identifier helpers for exporting spawned objects
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+
+// Bytes of text gathered before each write to the output file
+#ifndef DEBUG_ALIGNMENT_EXPORT_BUFFER
+#define DEBUG_ALIGNMENT_EXPORT_BUFFER 2048
+#endif
+
+// Longest identifier prefix produced by export_identifier(), including the terminator
+constexpr size_t EXPORT_IDENTIFIER_SIZE = 48;
+
+// Formats into a caller-owned buffer and hands it to the FILE in large writes, so an
+// export of any size costs no heap and no per-line stdio calls. Output is never
+// truncated: a line that does not fit an empty buffer is written straight through.
+class ExportStream {
+public:
+    ExportStream(FILE* out, char* buffer, size_t size);
+    ~ExportStream() { flush(); }
+    ExportStream(const ExportStream&) = delete;
+    ExportStream& operator=(const ExportStream&) = delete;
+
+    void print(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+    void write(const char* data, size_t length);
+    // s as a C string literal, quotes included
+    void write_quoted(const char* s);
+
+    bool flush();
+    bool ok() const { return ok_; }
+    size_t bytes_written() const { return written_ + used_; }
+
+private:
+    FILE* out_;
+    char* buffer_;
+    size_t size_;
+    size_t used_ = 0;
+    size_t written_ = 0;
+    bool ok_ = true;
+};
+
+// Upper-case C identifier from a display name ("Arc #12" -> "ARC_12"): anything that
+// is not a letter or digit becomes a single underscore, a leading digit gets one
+// prepended. Returns out.
+char* export_identifier(const char* name, char* out, size_t size = EXPORT_IDENTIFIER_SIZE);
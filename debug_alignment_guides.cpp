@@ -0,0 +1,94 @@
+/*
+File:   debug_alignment_guides.cpp
+Author: Will Jenkins
+Purpose: Sorted edge/center index for snapping objects to each other
+*/
+
+#include "debug_alignment_guides.hpp"
+
+void EdgeIndex::lines_of(Axis axis, const lv_area_t& box, int32_t out[3]) {
+    int32_t start = axis == AXIS_X ? box.x1 : box.y1;
+    int32_t end = axis == AXIS_X ? box.x2 : box.y2;
+    out[0] = start;
+    out[1] = start + (end - start) / 2;
+    out[2] = end;
+}
+
+void EdgeIndex::link(uint32_t slot) {
+    const Entry& entry = entries_[slot];
+    for (int axis = AXIS_X; axis <= AXIS_Y; axis++) {
+        int32_t values[3];
+        lines_of((Axis)axis, entry.box, values);
+        for (uint8_t kind = 0; kind < 3; kind++) {
+            lines_[axis].insert(Line{values[kind], slot, kind});
+        }
+    }
+}
+
+void EdgeIndex::unlink(uint32_t slot) {
+    const Entry& entry = entries_[slot];
+    for (int axis = AXIS_X; axis <= AXIS_Y; axis++) {
+        int32_t values[3];
+        lines_of((Axis)axis, entry.box, values);
+        for (uint8_t kind = 0; kind < 3; kind++) {
+            lines_[axis].erase(Line{values[kind], slot, kind});
+        }
+    }
+}
+
+void EdgeIndex::update(SlotHandle id, const lv_area_t& box) {
+    if (!id.valid()) return;
+    if (id.slot >= entries_.size()) entries_.resize(id.slot + 1);
+    Entry& entry = entries_[id.slot];
+    if (entry.live) {
+        if (entry.box.x1 == box.x1 && entry.box.y1 == box.y1 && entry.box.x2 == box.x2 &&
+            entry.box.y2 == box.y2) {
+            entry.id = id;
+            return;
+        }
+        unlink(id.slot);
+    }
+    entry.id = id;
+    entry.box = box;
+    entry.live = true;
+    link(id.slot);
+}
+
+void EdgeIndex::remove(SlotHandle id) {
+    if (id.slot >= entries_.size()) return;
+    Entry& entry = entries_[id.slot];
+    if (!entry.live || entry.id != id) return;
+    unlink(id.slot);
+    entry.live = false;
+}
+
+void EdgeIndex::clear() {
+    lines_[AXIS_X].clear();
+    lines_[AXIS_Y].clear();
+    entries_.clear();
+}
+
+EdgeIndex::Match EdgeIndex::snap(Axis axis, const lv_area_t& box, SlotHandle self, int32_t tolerance,
+                                 int direction) const {
+    Match best;
+    int32_t own[3];
+    lines_of(axis, box, own);
+    const std::set<Line>& lines = lines_[axis];
+
+    for (int32_t value : own) {
+        int32_t low = direction > 0 ? value : value - tolerance;
+        int32_t high = direction < 0 ? value : value + tolerance;
+        for (auto it = lines.lower_bound(Line{low, 0, 0}); it != lines.end() && it->value <= high; ++it) {
+            if (it->slot == self.slot) continue;
+            int32_t delta = it->value - value;
+            int32_t distance = delta < 0 ? -delta : delta;
+            if (!best.found || distance < (best.delta < 0 ? -best.delta : best.delta)) {
+                best.found = true;
+                best.delta = delta;
+                best.line = it->value;
+                best.other = entries_[it->slot].id;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,63 @@
+/*
+File:   debug_alignment_guides.hpp
+Author: Will Jenkins
+Purpose: Sorted edge/center index for snapping objects to each other
+*/
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include "debug_alignment_slot_map.hpp"
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Keeps every item's left/center/right lines and top/center/bottom lines in two
+// ordered sets, so matching a box against all other items is a lower_bound plus a
+// walk over the lines inside the tolerance window: O(log n + k) per query, O(log n)
+// per update.
+class EdgeIndex {
+public:
+    enum Axis { AXIS_X, AXIS_Y };
+
+    struct Match {
+        bool found = false;
+        int32_t delta = 0;  // Move the box by this much along the axis to align it
+        int32_t line = 0;   // Aligned coordinate, for drawing the guide
+        SlotHandle other;   // Item the box aligned to
+    };
+
+    void update(SlotHandle id, const lv_area_t& box);
+    void remove(SlotHandle id);
+    void clear();
+
+    // Closest pairing of the box's start/center/end lines on `axis` with another
+    // item's lines, |delta| <= tolerance. direction > 0 only accepts delta >= 0 and
+    // direction < 0 only delta <= 0, so an object being nudged snaps onto lines ahead
+    // of it but is never pulled back over one it just left.
+    Match snap(Axis axis, const lv_area_t& box, SlotHandle self, int32_t tolerance, int direction = 0) const;
+
+private:
+    struct Line {
+        int32_t value;
+        uint32_t slot;
+        uint8_t kind;  // 0 = start, 1 = center, 2 = end
+        bool operator<(const Line& other) const {
+            if (value != other.value) return value < other.value;
+            if (slot != other.slot) return slot < other.slot;
+            return kind < other.kind;
+        }
+    };
+    struct Entry {
+        SlotHandle id;
+        lv_area_t box;
+        bool live = false;
+    };
+
+    static void lines_of(Axis axis, const lv_area_t& box, int32_t out[3]);
+    void link(uint32_t slot);
+    void unlink(uint32_t slot);
+
+    std::set<Line> lines_[2];     // Indexed by Axis
+    std::vector<Entry> entries_;  // Indexed by SlotHandle::slot
+};
@@ -0,0 +1,84 @@
+/*
+File:   debug_alignment_heatmap.cpp
+Author: Will Jenkins
+Purpose: Coarse grid accumulating how often each part of the screen is redrawn
+*/
+
+#include "debug_alignment_heatmap.hpp"
+#include <algorithm>
+
+void RedrawHeatmap::reset(int32_t width, int32_t height, int32_t cell) {
+    width_ = std::max<int32_t>(0, width);
+    height_ = std::max<int32_t>(0, height);
+    cell_ = std::max<int32_t>(1, cell);
+    cols_ = (width_ + cell_ - 1) / cell_;
+    rows_ = (height_ + cell_ - 1) / cell_;
+    pixels_.assign((size_t)cols_ * (size_t)rows_, 0);
+    frames_ = 0;
+    total_ = 0;
+}
+
+void RedrawHeatmap::clear() {
+    std::fill(pixels_.begin(), pixels_.end(), 0);
+    frames_ = 0;
+    total_ = 0;
+}
+
+// Overlap with each column and each row is computed once, so an area costs one
+// multiply-add per cell it touches
+void RedrawHeatmap::add(const lv_area_t& area) {
+    int32_t x1 = std::max<int32_t>(area.x1, 0);
+    int32_t y1 = std::max<int32_t>(area.y1, 0);
+    int32_t x2 = std::min<int32_t>(area.x2, width_ - 1);
+    int32_t y2 = std::min<int32_t>(area.y2, height_ - 1);
+    if (x1 > x2 || y1 > y2) return;
+
+    int32_t col_first = x1 / cell_;
+    int32_t col_last = x2 / cell_;
+    int32_t row_first = y1 / cell_;
+    int32_t row_last = y2 / cell_;
+    for (int32_t row = row_first; row <= row_last; row++) {
+        int32_t top = std::max(y1, row * cell_);
+        int32_t bottom = std::min(y2, row * cell_ + cell_ - 1);
+        uint64_t h = (uint64_t)(bottom - top + 1);
+        uint64_t* counts = &pixels_[(size_t)row * (size_t)cols_];
+        for (int32_t col = col_first; col <= col_last; col++) {
+            int32_t left = std::max(x1, col * cell_);
+            int32_t right = std::min(x2, col * cell_ + cell_ - 1);
+            counts[col] += h * (uint64_t)(right - left + 1);
+        }
+    }
+    total_ += (uint64_t)(x2 - x1 + 1) * (uint64_t)(y2 - y1 + 1);
+}
+
+lv_area_t RedrawHeatmap::cell_area(int32_t col, int32_t row) const {
+    lv_area_t area;
+    area.x1 = col * cell_;
+    area.y1 = row * cell_;
+    area.x2 = std::min(area.x1 + cell_, width_) - 1;
+    area.y2 = std::min(area.y1 + cell_, height_) - 1;
+    return area;
+}
+
+uint32_t RedrawHeatmap::level(int32_t col, int32_t row) const {
+    if (frames_ == 0 || col < 0 || row < 0 || col >= cols_ || row >= rows_) return 0;
+    lv_area_t area = cell_area(col, row);
+    uint64_t size = (uint64_t)(area.x2 - area.x1 + 1) * (uint64_t)(area.y2 - area.y1 + 1);
+    uint64_t level = pixels_[(size_t)row * (size_t)cols_ + (size_t)col] * FULL / (size * frames_);
+    return (uint32_t)std::min<uint64_t>(level, FULL);
+}
+
+void RedrawHeatmap::hottest(int32_t& col, int32_t& row) const {
+    col = row = -1;
+    uint32_t best = 0;
+    for (int32_t r = 0; r < rows_; r++) {
+        for (int32_t c = 0; c < cols_; c++) {
+            uint32_t value = level(c, r);
+            if (value > best) {
+                best = value;
+                col = c;
+                row = r;
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+File:   debug_alignment_heatmap.hpp
+Author: Will Jenkins
+Purpose: Coarse grid accumulating how often each part of the screen is redrawn
+*/
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include <cstdint>
+#include <vector>
+
+// Redrawn pixels per cell of a grid laid over the screen, summed over frames. A cell's
+// level is the share of frames it was redrawn in, weighted by how much of the cell
+// each redraw covered: a widget that animates every frame shows as a solid block at
+// full level, one that redraws its whole parent shows the parent.
+class RedrawHeatmap {
+public:
+    static constexpr uint32_t FULL = 255;  // level() of a cell redrawn whole every frame
+
+    // New grid of `cell` px squares over a width x height screen; counts start at zero
+    void reset(int32_t width, int32_t height, int32_t cell);
+    void clear();
+
+    // One redrawn area in screen coordinates; the part off the grid is ignored
+    void add(const lv_area_t& area);
+    void end_frame() { frames_++; }
+
+    uint32_t frames() const { return frames_; }
+    uint64_t total_pixels() const { return total_; }
+    int32_t cols() const { return cols_; }
+    int32_t rows() const { return rows_; }
+
+    // Cell bounds in screen coordinates (edge cells can be smaller than `cell`)
+    lv_area_t cell_area(int32_t col, int32_t row) const;
+    // 0..FULL, see above
+    uint32_t level(int32_t col, int32_t row) const;
+    // Cell with the highest level, or -1/-1 before the first redraw
+    void hottest(int32_t& col, int32_t& row) const;
+
+private:
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t cell_ = 1;
+    int32_t cols_ = 0;
+    int32_t rows_ = 0;
+    uint32_t frames_ = 0;
+    uint64_t total_ = 0;
+    std::vector<uint64_t> pixels_;  // Row-major, one counter per cell
+};
@@ -0,0 +1,151 @@
+/*
+File:   debug_alignment_heatmap_overlay.cpp
+Author: Will Jenkins
+Purpose: Redraw heatmap overlay: display hooks feeding the grid and the draw over the parent screen
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// Heatmap cell size in pixels
+#ifndef DEBUG_ALIGNMENT_HEATMAP_CELL
+#define DEBUG_ALIGNMENT_HEATMAP_CELL 16
+#endif
+
+// How often the heatmap overlay is brought up to date. Each update redraws the whole
+// screen, and that frame is left out of the map.
+#ifndef DEBUG_ALIGNMENT_HEATMAP_PERIOD
+#define DEBUG_ALIGNMENT_HEATMAP_PERIOD 1000
+#endif
+
+RedrawHeatmap DebugAlignmentEnhanced::redraw_heatmap;
+lv_display_t* DebugAlignmentEnhanced::heatmap_display = nullptr;
+lv_timer_t* DebugAlignmentEnhanced::heatmap_timer = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::heatmap_button_label = nullptr;
+uint32_t DebugAlignmentEnhanced::heatmap_shown_frames = 0;
+bool DebugAlignmentEnhanced::heatmap_refresh_pending = false;
+bool DebugAlignmentEnhanced::heatmap_self_frame = false;
+
+namespace {
+
+// Cold to hot; a cell's level picks one, and hotter cells are drawn more opaque
+const uint32_t heat_colors[] = {0x2C7BB6, 0x00A6CA, 0x00CCBC, 0x90EB9D, 0xFFFF8C, 0xF9D057, 0xF29E2E, 0xD7191C};
+constexpr uint32_t HEAT_STEPS = sizeof(heat_colors) / sizeof(heat_colors[0]);
+
+// Color step of a non-zero heatmap level
+uint32_t heat_step(uint32_t level) {
+    return std::min<uint32_t>(HEAT_STEPS - 1, level * HEAT_STEPS / (RedrawHeatmap::FULL + 1));
+}
+
+}  // namespace
+
+// The grid covers the display, in the same coordinates as the flushed areas and the
+// layer the overlay draws on
+void DebugAlignmentEnhanced::set_redraw_heatmap(bool enabled) {
+    if (enabled == get_redraw_heatmap()) return;
+    if (enabled) {
+        lv_display_t* display = parent_screen ? lv_obj_get_display(parent_screen) : nullptr;
+        if (!display) return;
+        redraw_heatmap.reset(lv_display_get_horizontal_resolution(display),
+                             lv_display_get_vertical_resolution(display), DEBUG_ALIGNMENT_HEATMAP_CELL);
+        heatmap_display = display;
+        heatmap_shown_frames = 0;
+        heatmap_refresh_pending = false;
+        heatmap_self_frame = false;
+        lv_display_add_event_cb(display, heatmap_display_event, LV_EVENT_RENDER_START, nullptr);
+        lv_display_add_event_cb(display, heatmap_display_event, LV_EVENT_FLUSH_START, nullptr);
+        lv_display_add_event_cb(display, heatmap_display_event, LV_EVENT_RENDER_READY, nullptr);
+        lv_obj_add_event_cb(parent_screen, heatmap_draw_event, LV_EVENT_DRAW_POST, nullptr);
+        heatmap_timer = lv_timer_create(heatmap_timer_cb, DEBUG_ALIGNMENT_HEATMAP_PERIOD, nullptr);
+        DA_LOGI("Redraw heatmap on: %dx%d cells of %d px", (int)redraw_heatmap.cols(), (int)redraw_heatmap.rows(),
+                DEBUG_ALIGNMENT_HEATMAP_CELL);
+    } else {
+        lv_timer_delete(heatmap_timer);
+        heatmap_timer = nullptr;
+        lv_display_remove_event_cb_with_user_data(heatmap_display, heatmap_display_event, nullptr);
+        heatmap_display = nullptr;
+        if (parent_screen && lv_obj_is_valid(parent_screen)) {
+            lv_obj_remove_event_cb(parent_screen, heatmap_draw_event);
+            lv_obj_invalidate(parent_screen);
+        }
+        int32_t col = -1;
+        int32_t row = -1;
+        redraw_heatmap.hottest(col, row);
+        uint32_t frames = redraw_heatmap.frames();
+        if (frames && col >= 0) {
+            lv_area_t cell = redraw_heatmap.cell_area(col, row);
+            DA_LOGI("Redraw heatmap off: %u frames, %u px redrawn per frame, hottest cell at %d,%d redrawn %u%% of the time",
+                    (unsigned)frames, (unsigned)(redraw_heatmap.total_pixels() / frames), (int)cell.x1, (int)cell.y1,
+                    (unsigned)(redraw_heatmap.level(col, row) * 100 / RedrawHeatmap::FULL));
+        } else {
+            DA_LOGI("Redraw heatmap off: nothing was redrawn");
+        }
+    }
+    if (heatmap_button_label) lv_label_set_text(heatmap_button_label, enabled ? " Heat On" : " Heat");
+}
+
+void DebugAlignmentEnhanced::heatmap_toggle_event(lv_event_t*) { set_redraw_heatmap(!get_redraw_heatmap()); }
+
+void DebugAlignmentEnhanced::heatmap_display_event(lv_event_t* e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_RENDER_START:
+            heatmap_self_frame = heatmap_refresh_pending;
+            heatmap_refresh_pending = false;
+            break;
+        case LV_EVENT_FLUSH_START: {
+            const lv_area_t* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+            if (area && !heatmap_self_frame) redraw_heatmap.add(*area);
+            break;
+        }
+        case LV_EVENT_RENDER_READY:
+            if (!heatmap_self_frame) redraw_heatmap.end_frame();
+            heatmap_self_frame = false;
+            break;
+        default: break;
+    }
+}
+
+// Brings the whole overlay up to date, but only if something was redrawn since
+void DebugAlignmentEnhanced::heatmap_timer_cb(lv_timer_t*) {
+    if (!parent_screen || redraw_heatmap.frames() == heatmap_shown_frames) return;
+    heatmap_shown_frames = redraw_heatmap.frames();
+    heatmap_refresh_pending = true;
+    lv_obj_invalidate(parent_screen);
+}
+
+// Runs of neighbouring cells at the same color step go out as one rectangle; cells
+// never redrawn are left clear
+void DebugAlignmentEnhanced::heatmap_draw_event(lv_event_t* e) {
+    if (redraw_heatmap.frames() == 0) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    for (int32_t row = 0; row < redraw_heatmap.rows(); row++) {
+        int32_t col = 0;
+        while (col < redraw_heatmap.cols()) {
+            uint32_t level = redraw_heatmap.level(col, row);
+            if (level == 0) {
+                col++;
+                continue;
+            }
+            uint32_t step = heat_step(level);
+            int32_t end = col + 1;
+            while (end < redraw_heatmap.cols()) {
+                uint32_t next = redraw_heatmap.level(end, row);
+                if (next == 0 || heat_step(next) != step) break;
+                end++;
+            }
+            lv_area_t area = redraw_heatmap.cell_area(col, row);
+            area.x2 = redraw_heatmap.cell_area(end - 1, row).x2;
+            rect.bg_color = lv_color_hex(heat_colors[step]);
+            rect.bg_opa = (lv_opa_t)(LV_OPA_30 + step * 16);
+            lv_draw_rect(layer, &rect, &area);
+            col = end;
+        }
+    }
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
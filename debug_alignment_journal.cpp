@@ -0,0 +1,97 @@
+/*
+File:   debug_alignment_journal.cpp
+Author: Will Jenkins
+Purpose: Bounded undo/redo journal of per-field deltas
+*/
+
+#include "debug_alignment_journal.hpp"
+
+UndoJournal::UndoJournal(size_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+void UndoJournal::begin_command() {
+    pending_.clear();
+    recording_ = true;
+}
+
+void UndoJournal::record(SlotHandle target, uint8_t field, int32_t old_value, int32_t new_value, bool mergeable) {
+    if (!recording_ || old_value == new_value) return;
+    pending_mergeable_ = pending_.empty() && mergeable;
+    pending_.push_back(JournalDelta{target, old_value, new_value, field, 0});
+}
+
+void UndoJournal::end_command() {
+    recording_ = false;
+    if (pending_.empty() || pending_.size() > UINT8_MAX) {
+        pending_.clear();
+        return;
+    }
+    // Anything new invalidates what was undone
+    redo_.clear();
+
+    const JournalDelta& next = pending_.front();
+    if (merge_open_ && pending_mergeable_ && !undo_.empty() && undo_.back().command_size == 1) {
+        JournalDelta& last = undo_.back();
+        bool same_direction = (next.new_value > next.old_value) == (last.new_value > last.old_value);
+        if (last.target == next.target && last.field == next.field && same_direction) {
+            last.new_value = next.new_value;
+            pending_.clear();
+            return;
+        }
+    }
+
+    pending_.front().command_size = (uint8_t)pending_.size();
+    undo_.insert(undo_.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    merge_open_ = true;
+    trim();
+}
+
+bool UndoJournal::undo(ApplyFn apply) {
+    if (undo_.empty()) return false;
+    // Walk back to the command's first delta, then restore in reverse order
+    size_t first = undo_.size() - 1;
+    while (first > 0 && undo_[first].command_size == 0) first--;
+    for (size_t i = undo_.size(); i-- > first;) {
+        apply(undo_[i], undo_[i].old_value);
+    }
+    redo_.insert(redo_.end(), undo_.begin() + first, undo_.end());
+    undo_.erase(undo_.begin() + first, undo_.end());
+    merge_open_ = false;
+    return true;
+}
+
+bool UndoJournal::redo(ApplyFn apply) {
+    if (redo_.empty()) return false;
+    size_t first = redo_.size() - 1;
+    while (first > 0 && redo_[first].command_size == 0) first--;
+    for (size_t i = first; i < redo_.size(); i++) {
+        apply(redo_[i], redo_[i].new_value);
+    }
+    undo_.insert(undo_.end(), redo_.begin() + first, redo_.end());
+    redo_.erase(redo_.begin() + first, redo_.end());
+    merge_open_ = false;
+    return true;
+}
+
+void UndoJournal::clear() {
+    undo_.clear();
+    redo_.clear();
+    pending_.clear();
+    recording_ = false;
+    merge_open_ = false;
+}
+
+void UndoJournal::set_budget(size_t budget_bytes) {
+    budget_bytes_ = budget_bytes;
+    trim();
+}
+
+// Drop whole commands from the old end until the journal fits again
+void UndoJournal::trim() {
+    while (!undo_.empty() && bytes_used() > budget_bytes_) {
+        undo_.pop_front();
+        while (!undo_.empty() && undo_.front().command_size == 0) {
+            undo_.pop_front();
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+File:   debug_alignment_journal.hpp
+Author: Will Jenkins
+Purpose: Bounded undo/redo journal of per-field deltas
+*/
+
+#pragma once
+
+#include "debug_alignment_slot_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Bytes of deltas kept for undo (redo is bounded by what was undone). At 20 bytes a
+// delta the default holds a couple of hundred edits.
+#ifndef DEBUG_ALIGNMENT_UNDO_BUDGET
+#define DEBUG_ALIGNMENT_UNDO_BUDGET 4096
+#endif
+
+// One field of one object changing from old_value to new_value. What a field id means
+// is up to the owner of the journal.
+struct JournalDelta {
+    SlotHandle target;
+    int32_t old_value;
+    int32_t new_value;
+    uint8_t field;
+    uint8_t command_size;  // Deltas in the command on its first delta, 0 on the rest
+};
+
+// Commands are runs of deltas recorded between begin_command() and end_command(). A
+// single-delta command on a field recorded as mergeable that moves the same field of the
+// same object in the same direction as the previous one is folded into it, so ten nudges
+// right undo as one. Fields that are not quantities (flags, indices) never merge.
+// When the budget is exceeded the oldest commands are dropped.
+class UndoJournal {
+public:
+    using ApplyFn = void (*)(const JournalDelta& delta, int32_t value);
+
+    explicit UndoJournal(size_t budget_bytes = DEBUG_ALIGNMENT_UNDO_BUDGET);
+
+    void begin_command();
+    void record(SlotHandle target, uint8_t field, int32_t old_value, int32_t new_value, bool mergeable = false);
+    void end_command();
+
+    // Hands each delta of the newest command to apply() with the value to restore
+    // (old on undo, new on redo). False if there was nothing to undo/redo.
+    bool undo(ApplyFn apply);
+    bool redo(ApplyFn apply);
+
+    // The next command starts a new entry even if it could have merged
+    void break_merge() { merge_open_ = false; }
+    void clear();
+
+    void set_budget(size_t budget_bytes);
+    size_t budget() const { return budget_bytes_; }
+    size_t bytes_used() const { return (undo_.size() + redo_.size()) * sizeof(JournalDelta); }
+    bool can_undo() const { return !undo_.empty(); }
+    bool can_redo() const { return !redo_.empty(); }
+
+private:
+    void trim();
+
+    std::deque<JournalDelta> undo_;    // Oldest command at the front
+    std::vector<JournalDelta> redo_;   // Most recently undone command at the back
+    std::vector<JournalDelta> pending_;
+    size_t budget_bytes_;
+    bool recording_ = false;
+    bool merge_open_ = false;
+    bool pending_mergeable_ = false;  // pending_ is one delta on a mergeable field
+};
@@ -0,0 +1,135 @@
+/*
+File:   debug_alignment_log.cpp
+Author: Will Jenkins
+Purpose: Ring-buffered log sink for the debug alignment overlay
+*/
+
+#include "debug_alignment_log.hpp"
+#include "debug_alignment_ring.hpp"
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+lv_timer_t* DebugAlignmentLog::drain_timer = nullptr;
+
+namespace {
+
+void stdout_sink(const char* text, size_t len) {
+    fwrite(text, 1, len, stdout);
+}
+
+DebugAlignmentLog::Sink sink = stdout_sink;
+
+#if DEBUG_ALIGNMENT_LOG_LEVEL > DA_LOG_LEVEL_NONE
+
+struct LogRecord {
+    uint8_t level;
+    uint16_t len;
+    char text[DebugAlignmentLog::RECORD_SIZE - 4];
+};
+static_assert(sizeof(LogRecord) == DebugAlignmentLog::RECORD_SIZE, "LogRecord layout");
+
+SpscRing<LogRecord, DEBUG_ALIGNMENT_LOG_RING_SIZE> ring;
+std::atomic<uint32_t> dropped{0};
+uint32_t dropped_reported = 0;
+
+const char* level_tag(int level) {
+    switch (level) {
+        case DA_LOG_LEVEL_ERROR: return "[ERROR] ";
+        case DA_LOG_LEVEL_WARN: return "[WARN] ";
+        case DA_LOG_LEVEL_INFO: return "[INFO] ";
+        default: return "[DEBUG] ";
+    }
+}
+
+// Tag, text and newline go to the sink in one call
+void emit(int level, const char* text, size_t len) {
+    char line[DebugAlignmentLog::RECORD_SIZE + 16];
+    int n = snprintf(line, sizeof(line), "%s%.*s\n", level_tag(level), (int)len, text);
+    if (n > 0) sink(line, (size_t)n < sizeof(line) ? (size_t)n : sizeof(line) - 1);
+}
+
+#endif
+
+}  // namespace
+
+void DebugAlignmentLog::write(int level, const char* fmt, ...) {
+#if DEBUG_ALIGNMENT_LOG_LEVEL > DA_LOG_LEVEL_NONE
+    LogRecord* record = ring.begin_push();
+    if (!record) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(record->text, sizeof(record->text), fmt, args);
+    va_end(args);
+    if (n < 0) n = 0;
+    if (n >= (int)sizeof(record->text)) n = sizeof(record->text) - 1;  // Truncated
+    record->level = (uint8_t)level;
+    record->len = (uint16_t)n;
+    ring.end_push();
+#else
+    (void)level;
+    (void)fmt;
+#endif
+}
+
+size_t DebugAlignmentLog::drain(size_t max_records) {
+#if DEBUG_ALIGNMENT_LOG_LEVEL > DA_LOG_LEVEL_NONE
+    size_t written = 0;
+    while (written < max_records) {
+        const LogRecord* record = ring.front();
+        if (!record) break;
+        emit(record->level, record->text, record->len);
+        ring.pop_front();
+        written++;
+    }
+    uint32_t total_dropped = dropped.load(std::memory_order_relaxed);
+    if (total_dropped != dropped_reported) {
+        char note[64];
+        int n = snprintf(note, sizeof(note), "%u log messages dropped (ring full)",
+                         (unsigned)(total_dropped - dropped_reported));
+        emit(DA_LOG_LEVEL_WARN, note, (size_t)n);
+        dropped_reported = total_dropped;
+    }
+    return written;
+#else
+    (void)max_records;
+    return 0;
+#endif
+}
+
+// A bounded batch per tick keeps a backed-up ring from stalling one frame
+void DebugAlignmentLog::drain_timer_cb(lv_timer_t*) {
+    drain(16);
+}
+
+void DebugAlignmentLog::start(uint32_t period_ms) {
+#if DEBUG_ALIGNMENT_LOG_LEVEL > DA_LOG_LEVEL_NONE
+    if (drain_timer) return;
+    drain_timer = lv_timer_create(drain_timer_cb, period_ms, nullptr);
+#else
+    (void)period_ms;
+#endif
+}
+
+void DebugAlignmentLog::stop() {
+    if (drain_timer) {
+        lv_timer_delete(drain_timer);
+        drain_timer = nullptr;
+    }
+    drain();
+}
+
+void DebugAlignmentLog::set_sink(Sink new_sink) {
+    sink = new_sink ? new_sink : stdout_sink;
+}
+
+uint32_t DebugAlignmentLog::dropped_count() {
+#if DEBUG_ALIGNMENT_LOG_LEVEL > DA_LOG_LEVEL_NONE
+    return dropped.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
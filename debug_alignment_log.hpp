@@ -0,0 +1,86 @@
+/*
+File:   debug_alignment_log.hpp
+Author: Will Jenkins
+Purpose: Compile-time leveled logging for the debug alignment overlay
+*/
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include <cstddef>
+#include <cstdint>
+
+#define DA_LOG_LEVEL_NONE  0
+#define DA_LOG_LEVEL_ERROR 1
+#define DA_LOG_LEVEL_WARN  2
+#define DA_LOG_LEVEL_INFO  3
+#define DA_LOG_LEVEL_DEBUG 4
+
+// Messages above this level compile to nothing. Release builds (NDEBUG) log nothing
+// unless a level is passed explicitly, e.g. -DDEBUG_ALIGNMENT_LOG_LEVEL=DA_LOG_LEVEL_WARN
+#ifndef DEBUG_ALIGNMENT_LOG_LEVEL
+#ifdef NDEBUG
+#define DEBUG_ALIGNMENT_LOG_LEVEL DA_LOG_LEVEL_NONE
+#else
+#define DEBUG_ALIGNMENT_LOG_LEVEL DA_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// Records held between drains; each costs DebugAlignmentLog::RECORD_SIZE bytes of RAM
+#ifndef DEBUG_ALIGNMENT_LOG_RING_SIZE
+#define DEBUG_ALIGNMENT_LOG_RING_SIZE 64
+#endif
+
+// Disabled levels leave only an unevaluated sizeof: no code or strings are emitted, but
+// arguments still count as used and the format is still checked
+#define DA_LOG_DISCARD(...) ((void)sizeof((DebugAlignmentLog::write(DA_LOG_LEVEL_NONE, __VA_ARGS__), 0)))
+
+#if DEBUG_ALIGNMENT_LOG_LEVEL >= DA_LOG_LEVEL_ERROR
+#define DA_LOGE(...) DebugAlignmentLog::write(DA_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define DA_LOGE(...) DA_LOG_DISCARD(__VA_ARGS__)
+#endif
+#if DEBUG_ALIGNMENT_LOG_LEVEL >= DA_LOG_LEVEL_WARN
+#define DA_LOGW(...) DebugAlignmentLog::write(DA_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define DA_LOGW(...) DA_LOG_DISCARD(__VA_ARGS__)
+#endif
+#if DEBUG_ALIGNMENT_LOG_LEVEL >= DA_LOG_LEVEL_INFO
+#define DA_LOGI(...) DebugAlignmentLog::write(DA_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define DA_LOGI(...) DA_LOG_DISCARD(__VA_ARGS__)
+#endif
+#if DEBUG_ALIGNMENT_LOG_LEVEL >= DA_LOG_LEVEL_DEBUG
+#define DA_LOGD(...) DebugAlignmentLog::write(DA_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define DA_LOGD(...) DA_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+// Handlers only format into a lock-free ring; a low-priority lv_timer writes the ring
+// to the sink (stdout by default) so slow UART output stays off the hot path.
+class DebugAlignmentLog {
+public:
+    static constexpr size_t RECORD_SIZE = 128;
+    using Sink = void (*)(const char* text, size_t len);
+
+    // Format one message into the ring; dropped (and counted) when the ring is full
+    static void write(int level, const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    // Write up to max_records pending messages to the sink; returns how many were written
+    static size_t drain(size_t max_records = SIZE_MAX);
+
+    // Drain timer owned by the overlay: created in init(), removed in cleanup()
+    static void start(uint32_t period_ms = 50);
+    static void stop();
+
+    static void set_sink(Sink sink);
+    static uint32_t dropped_count();
+
+private:
+    static void drain_timer_cb(lv_timer_t* timer);
+    static lv_timer_t* drain_timer;
+};
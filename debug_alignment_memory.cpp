@@ -0,0 +1,137 @@
+/*
+File:   debug_alignment_memory.cpp
+Author: Will Jenkins
+Purpose: LVGL heap totals and a per-object RAM bill of materials for the spawned scene
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// RAM the finished screen may take; the bill shows the scene against it
+#ifndef DEBUG_ALIGNMENT_RAM_BUDGET
+#define DEBUG_ALIGNMENT_RAM_BUDGET (512 * 1024)
+#endif
+
+// Objects listed in the panel report; the export lists all of them
+#ifndef DEBUG_ALIGNMENT_MEMORY_ROWS
+#define DEBUG_ALIGNMENT_MEMORY_ROWS 12
+#endif
+
+lv_obj_t* DebugAlignmentEnhanced::memory_label = nullptr;
+bool DebugAlignmentEnhanced::creation_marked = false;
+
+namespace {
+
+int64_t heap_used() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return (int64_t)mon.total_size - (int64_t)mon.free_size;
+}
+
+unsigned percent(size_t part, size_t whole) { return whole ? (unsigned)((uint64_t)part * 100 / whole) : 0; }
+
+}  // namespace
+
+DebugAlignmentEnhanced::HeapMark DebugAlignmentEnhanced::heap_mark() {
+    HeapMark mark;
+    mark.used = heap_used();
+    mark.canvas = (int64_t)canvas_pool.held_bytes();
+    mark.taken = true;
+    return mark;
+}
+
+// Heap growth since the mark with the pool's own allocations taken out
+int32_t DebugAlignmentEnhanced::heap_since(const HeapMark& mark) {
+    HeapMark now = heap_mark();
+    return (int32_t)((now.used - mark.used) - (now.canvas - mark.canvas));
+}
+
+// Left untaken inside a creation mark, which charges the whole object at once
+DebugAlignmentEnhanced::HeapMark DebugAlignmentEnhanced::write_mark() {
+    return creation_marked ? HeapMark() : heap_mark();
+}
+
+void DebugAlignmentEnhanced::charge_write(SpawnedObject& obj, const HeapMark& mark) {
+    if (mark.taken) obj.heap_bytes += heap_since(mark);
+}
+
+size_t DebugAlignmentEnhanced::canvas_bytes(const SpawnedObject& obj) {
+    if (obj.type != WidgetType::CANVAS || !obj.object) return 0;
+    CanvasBufferPool::Buffer buffer = canvas_pool.buffer(obj.object);
+    return buffer.data ? CanvasBufferPool::buffer_size(buffer.width, buffer.height, buffer.format) : 0;
+}
+
+int32_t DebugAlignmentEnhanced::get_object_ram(ObjectHandle handle) {
+    const SpawnedObject* obj = spawned_objects.get(handle);
+    return obj ? obj->heap_bytes + (int32_t)canvas_bytes(*obj) : 0;
+}
+
+// An object whose edits freed more than it took counts as zero, not as a credit
+size_t DebugAlignmentEnhanced::get_scene_ram() {
+    size_t total = 0;
+    for (const auto& obj : spawned_objects) {
+        total += (size_t)std::max<int32_t>(0, obj.heap_bytes) + canvas_bytes(obj);
+    }
+    return total;
+}
+
+void DebugAlignmentEnhanced::memory_refresh_event(lv_event_t*) { refresh_memory_report(); }
+
+// Heap totals, then the scene against the budget and the first objects in list order
+void DebugAlignmentEnhanced::refresh_memory_report() {
+    if (!memory_label) return;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    std::string text;
+    char line[160];
+    if (mon.total_size) {
+        size_t used = mon.total_size - mon.free_size;
+        snprintf(line, sizeof(line), "LVGL heap: %u of %u B used (%u%%), peak %u B\n%u%% fragmented, largest free block %u B\n",
+                 (unsigned)used, (unsigned)mon.total_size, (unsigned)mon.used_pct, (unsigned)mon.max_used,
+                 (unsigned)mon.frag_pct, (unsigned)mon.free_biggest_size);
+    } else {
+        snprintf(line, sizeof(line), "LVGL heap: not monitored (LVGL is not using its builtin allocator)\n");
+    }
+    text += line;
+    size_t scene = get_scene_ram();
+    snprintf(line, sizeof(line), "Scene: %u B of %u B budget (%u%%)%s", (unsigned)scene, (unsigned)DEBUG_ALIGNMENT_RAM_BUDGET,
+             percent(scene, DEBUG_ALIGNMENT_RAM_BUDGET), scene > DEBUG_ALIGNMENT_RAM_BUDGET ? "  OVER BUDGET" : "");
+    text += line;
+    int shown = 0;
+    for (const auto& obj : spawned_objects) {
+        if (shown == DEBUG_ALIGNMENT_MEMORY_ROWS) {
+            snprintf(line, sizeof(line), "\n  ... %d more in the export", spawned_objects.size() - shown);
+            text += line;
+            break;
+        }
+        size_t canvas = canvas_bytes(obj);
+        if (canvas) {
+            snprintf(line, sizeof(line), "\n  %-16s %7d B + %u B canvas", obj.name.c_str(), (int)obj.heap_bytes, (unsigned)canvas);
+        } else {
+            snprintf(line, sizeof(line), "\n  %-16s %7d B", obj.name.c_str(), (int)obj.heap_bytes);
+        }
+        text += line;
+        shown++;
+    }
+    lv_label_set_text(memory_label, text.c_str());
+}
+
+// Comment block ahead of the #defines: one row per object, then the total and budget
+void DebugAlignmentEnhanced::export_memory_bill(ExportStream& out) {
+    if (spawned_objects.empty()) return;
+    out.print("// RAM bill of materials (LVGL heap per object incl. children and styles, plus canvas buffers)\n");
+    for (const auto& obj : spawned_objects) {
+        size_t canvas = canvas_bytes(obj);
+        out.print("//   %-16s %7d B heap %8u B canvas\n", obj.name.c_str(), (int)obj.heap_bytes, (unsigned)canvas);
+    }
+    size_t scene = get_scene_ram();
+    out.print("//   Total %u B of %u B budget (%u%%)%s\n\n", (unsigned)scene, (unsigned)DEBUG_ALIGNMENT_RAM_BUDGET,
+              percent(scene, DEBUG_ALIGNMENT_RAM_BUDGET), scene > DEBUG_ALIGNMENT_RAM_BUDGET ? ", OVER BUDGET" : "");
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
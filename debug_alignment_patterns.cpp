@@ -0,0 +1,392 @@
+/*
+File:   debug_alignment_patterns.cpp
+Author: Will Jenkins
+Purpose: Canvas test patterns written straight into a pixel buffer, vectorized where available
+*/
+
+#include "debug_alignment_patterns.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if DEBUG_ALIGNMENT_PATTERN_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define PATTERN_SSE2 1
+#elif DEBUG_ALIGNMENT_PATTERN_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define PATTERN_NEON 1
+#endif
+
+#if defined(PATTERN_SSE2) || defined(PATTERN_NEON)
+#define PATTERN_SIMD 1
+#endif
+
+namespace {
+
+constexpr int CHECKER_SHIFT = 3;  // 8 px cells
+constexpr int NOISE_LANES = 4;
+
+// Every pattern is computed as 0xAARRGGBB and converted on store. Channels are scaled
+// by a 0..255 level as (c * (level + 1)) >> 8: exact at both ends, and the product
+// fits in 16 bits, which is all SSE2 can multiply per lane.
+inline uint32_t scale(uint32_t channel, uint32_t level) { return (channel * (level + 1)) >> 8; }
+
+inline uint16_t to_rgb565(uint32_t p) {
+    return (uint16_t)(((p >> 8) & 0xF800) | ((p >> 5) & 0x07E0) | ((p >> 3) & 0x001F));
+}
+
+// Same weights as lv_color_luminance()
+inline uint8_t to_l8(uint32_t p) {
+    return (uint8_t)((((p >> 16) & 0xFF) * 76 + ((p >> 8) & 0xFF) * 150 + (p & 0xFF) * 29) >> 8);
+}
+
+inline void store_pixel(uint8_t* row, uint32_t x, PatternFormat format, uint32_t p) {
+    switch (format) {
+        case PatternFormat::RGB565: {
+            uint16_t v = to_rgb565(p);
+            memcpy(row + x * 2, &v, sizeof(v));
+            break;
+        }
+        case PatternFormat::ARGB8888: memcpy(row + x * 4, &p, sizeof(p)); break;
+        case PatternFormat::L8: row[x] = to_l8(p); break;
+    }
+}
+
+uint32_t bytes_per_pixel(PatternFormat format) {
+    switch (format) {
+        case PatternFormat::RGB565: return 2;
+        case PatternFormat::ARGB8888: return 4;
+        default: return 1;
+    }
+}
+
+inline uint32_t xorshift(uint32_t s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Noise lanes are seeded per row, so each row is generated on its own
+uint32_t noise_seed(uint32_t seed, uint32_t y, uint32_t lane) {
+    uint32_t h = seed ^ (y * 0x9E3779B9u) ^ (lane * 0x85EBCA6Bu);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h | 1;  // xorshift stays at zero once there
+}
+
+#if PATTERN_SIMD
+// Four 32-bit lanes; the kernels below are written once against these
+#if PATTERN_SSE2
+using V = __m128i;
+inline V v_set1(uint32_t a) { return _mm_set1_epi32((int)a); }
+inline V v_set(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return _mm_setr_epi32((int)a, (int)b, (int)c, (int)d);
+}
+inline V v_add(V a, V b) { return _mm_add_epi32(a, b); }
+inline V v_and(V a, V b) { return _mm_and_si128(a, b); }
+inline V v_or(V a, V b) { return _mm_or_si128(a, b); }
+inline V v_xor(V a, V b) { return _mm_xor_si128(a, b); }
+template <int N> inline V v_shl(V a) { return _mm_slli_epi32(a, N); }
+template <int N> inline V v_shr(V a) { return _mm_srli_epi32(a, N); }
+// Lane products below 65536 only (16-bit multiply on zero-extended lanes)
+inline V v_mul_small(V a, V b) { return _mm_mullo_epi16(a, b); }
+inline V v_eq(V a, V b) { return _mm_cmpeq_epi32(a, b); }
+inline V v_select(V mask, V a, V b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+inline void v_store_u32x4(uint8_t* dst, V a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a); }
+// Lanes narrowed to 16 bits; packs saturates signed, so shift the range through it
+inline void v_store_u16x8(uint8_t* dst, V a, V b) {
+    const V bias = _mm_set1_epi32(0x8000);
+    V packed = _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_xor_si128(packed, _mm_set1_epi16((short)0x8000)));
+}
+// Lanes below 256 narrowed to bytes
+inline void v_store_u8x16(uint8_t* dst, V a, V b, V c, V d) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+}
+#else
+using V = uint32x4_t;
+inline V v_set1(uint32_t a) { return vdupq_n_u32(a); }
+inline V v_set(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    const uint32_t lanes[4] = {a, b, c, d};
+    return vld1q_u32(lanes);
+}
+inline V v_add(V a, V b) { return vaddq_u32(a, b); }
+inline V v_and(V a, V b) { return vandq_u32(a, b); }
+inline V v_or(V a, V b) { return vorrq_u32(a, b); }
+inline V v_xor(V a, V b) { return veorq_u32(a, b); }
+template <int N> inline V v_shl(V a) { return vshlq_n_u32(a, N); }
+template <int N> inline V v_shr(V a) { return vshrq_n_u32(a, N); }
+inline V v_mul_small(V a, V b) { return vmulq_u32(a, b); }
+inline V v_eq(V a, V b) { return vceqq_u32(a, b); }
+inline V v_select(V mask, V a, V b) { return vbslq_u32(mask, a, b); }
+inline void v_store_u32x4(uint8_t* dst, V a) { vst1q_u8(dst, vreinterpretq_u8_u32(a)); }
+inline void v_store_u16x8(uint8_t* dst, V a, V b) {
+    vst1q_u8(dst, vreinterpretq_u8_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b))));
+}
+inline void v_store_u8x16(uint8_t* dst, V a, V b, V c, V d) {
+    uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+    uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+    vst1q_u8(dst, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+}
+#endif
+
+inline V v_rgb565(V p) {
+    return v_or(v_or(v_and(v_shr<8>(p), v_set1(0xF800)), v_and(v_shr<5>(p), v_set1(0x07E0))),
+                v_and(v_shr<3>(p), v_set1(0x001F)));
+}
+
+inline V v_l8(V p) {
+    const V mask = v_set1(0xFF);
+    V r = v_mul_small(v_and(v_shr<16>(p), mask), v_set1(76));
+    V g = v_mul_small(v_and(v_shr<8>(p), mask), v_set1(150));
+    V b = v_mul_small(v_and(p, mask), v_set1(29));
+    return v_shr<8>(v_add(v_add(r, g), b));
+}
+#endif  // PATTERN_SIMD
+
+// The color scaled by a brightness level, fully opaque
+struct Shade {
+    uint32_t r, g, b;
+    explicit Shade(uint32_t color) : r((color >> 16) & 0xFF), g((color >> 8) & 0xFF), b(color & 0xFF) {}
+    uint32_t pixel(uint32_t level) const {
+        return 0xFF000000u | scale(r, level) << 16 | scale(g, level) << 8 | scale(b, level);
+    }
+#if PATTERN_SIMD
+    V pixel(V level) const {
+        V next = v_add(level, v_set1(1));
+        V rv = v_shr<8>(v_mul_small(v_set1(r), next));
+        V gv = v_shr<8>(v_mul_small(v_set1(g), next));
+        V bv = v_shr<8>(v_mul_small(v_set1(b), next));
+        return v_or(v_or(v_set1(0xFF000000u), v_shl<16>(rv)), v_or(v_shl<8>(gv), bv));
+    }
+#endif
+};
+
+// Kernels produce one row at a time: pixel(x) for any x, or next4() for four pixels
+// at a time from x = 0 between begin_simd() and end_simd(). Rows of ROW_INVARIANT
+// kernels are all alike, so only the first is generated.
+struct SolidKernel {
+    static constexpr bool ROW_INVARIANT = true;
+    uint32_t color;
+    explicit SolidKernel(uint32_t rgb) : color(0xFF000000u | rgb) {}
+    void begin_row(uint32_t) {}
+    uint32_t pixel(uint32_t) const { return color; }
+#if PATTERN_SIMD
+    void begin_simd() {}
+    V next4() { return v_set1(color); }
+    void end_simd() {}
+#endif
+};
+
+struct GradientKernel {
+    static constexpr bool ROW_INVARIANT = false;
+    Shade shade;
+    uint32_t step;  // 16.16 level per pixel along x + y
+    uint32_t y = 0;
+    GradientKernel(const PatternTarget& target, uint32_t color)
+        : shade(color), step((255u << 16) / std::max<uint32_t>(1, target.width + target.height - 2)) {}
+    void begin_row(uint32_t row) { y = row; }
+    uint32_t pixel(uint32_t x) const { return shade.pixel(((x + y) * step) >> 16); }
+#if PATTERN_SIMD
+    V acc;
+    void begin_simd() { acc = v_set(y * step, (y + 1) * step, (y + 2) * step, (y + 3) * step); }
+    V next4() {
+        V level = v_shr<16>(acc);
+        acc = v_add(acc, v_set1(4 * step));
+        return shade.pixel(level);
+    }
+    void end_simd() {}
+#endif
+};
+
+struct CheckerKernel {
+    static constexpr bool ROW_INVARIANT = false;
+    uint32_t on, off;
+    uint32_t row_phase = 0;
+    explicit CheckerKernel(uint32_t color) : on(0xFF000000u | color), off(0xFF000000u | ((color >> 1) & 0x7F7F7F)) {}
+    void begin_row(uint32_t y) { row_phase = (y >> CHECKER_SHIFT) & 1; }
+    uint32_t pixel(uint32_t x) const { return (((x >> CHECKER_SHIFT) ^ row_phase) & 1) ? off : on; }
+#if PATTERN_SIMD
+    V xs;
+    void begin_simd() { xs = v_set(0, 1, 2, 3); }
+    V next4() {
+        V odd = v_and(v_xor(v_shr<CHECKER_SHIFT>(xs), v_set1(row_phase)), v_set1(1));
+        xs = v_add(xs, v_set1(4));
+        return v_select(v_eq(odd, v_set1(1)), v_set1(off), v_set1(on));
+    }
+    void end_simd() {}
+#endif
+};
+
+struct AlphaRampKernel {
+    static constexpr bool ROW_INVARIANT = true;
+    Shade shade;
+    uint32_t color;
+    uint32_t step;  // 16.16 alpha per pixel
+    bool has_alpha;
+    AlphaRampKernel(const PatternTarget& target, uint32_t rgb)
+        : shade(rgb), color(rgb), step((255u << 16) / std::max<uint32_t>(1, target.width - 1)),
+          has_alpha(target.format == PatternFormat::ARGB8888) {}
+    void begin_row(uint32_t) {}
+    uint32_t pixel(uint32_t x) const {
+        uint32_t alpha = (x * step) >> 16;
+        return has_alpha ? alpha << 24 | color : shade.pixel(alpha);
+    }
+#if PATTERN_SIMD
+    V acc;
+    void begin_simd() { acc = v_set(0, step, 2 * step, 3 * step); }
+    V next4() {
+        V alpha = v_shr<16>(acc);
+        acc = v_add(acc, v_set1(4 * step));
+        return has_alpha ? v_or(v_shl<24>(alpha), v_set1(color)) : shade.pixel(alpha);
+    }
+    void end_simd() {}
+#endif
+};
+
+// NOISE_LANES interleaved xorshift generators: pixel x takes lane x % 4, and all lanes
+// step together every four pixels, which is exactly one vector step
+struct NoiseKernel {
+    static constexpr bool ROW_INVARIANT = false;
+    Shade shade;
+    uint32_t seed;
+    uint32_t lanes[NOISE_LANES];
+    NoiseKernel(uint32_t color, uint32_t seed_value) : shade(color), seed(seed_value) {}
+    void begin_row(uint32_t y) {
+        for (int i = 0; i < NOISE_LANES; i++) lanes[i] = noise_seed(seed, y, (uint32_t)i);
+    }
+    uint32_t pixel(uint32_t x) {
+        if ((x % NOISE_LANES) == 0) {
+            for (uint32_t& lane : lanes) lane = xorshift(lane);
+        }
+        return shade.pixel(lanes[x % NOISE_LANES] >> 24);
+    }
+#if PATTERN_SIMD
+    V state;
+    void begin_simd() { state = v_set(lanes[0], lanes[1], lanes[2], lanes[3]); }
+    V next4() {
+        state = v_xor(state, v_shl<13>(state));
+        state = v_xor(state, v_shr<17>(state));
+        state = v_xor(state, v_shl<5>(state));
+        return shade.pixel(v_shr<24>(state));
+    }
+    void end_simd() { v_store_u32x4(reinterpret_cast<uint8_t*>(lanes), state); }
+#endif
+};
+
+#if PATTERN_SIMD
+// Whole 16-pixel blocks from the start of the row; returns where the scalar tail starts
+template <typename Kernel>
+uint32_t fill_row_simd(uint8_t* row, uint32_t width, PatternFormat format, Kernel& kernel) {
+    kernel.begin_simd();
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        V p0 = kernel.next4();
+        V p1 = kernel.next4();
+        V p2 = kernel.next4();
+        V p3 = kernel.next4();
+        switch (format) {
+            case PatternFormat::RGB565:
+                v_store_u16x8(row + x * 2, v_rgb565(p0), v_rgb565(p1));
+                v_store_u16x8(row + x * 2 + 16, v_rgb565(p2), v_rgb565(p3));
+                break;
+            case PatternFormat::ARGB8888:
+                v_store_u32x4(row + x * 4, p0);
+                v_store_u32x4(row + x * 4 + 16, p1);
+                v_store_u32x4(row + x * 4 + 32, p2);
+                v_store_u32x4(row + x * 4 + 48, p3);
+                break;
+            case PatternFormat::L8: v_store_u8x16(row + x, v_l8(p0), v_l8(p1), v_l8(p2), v_l8(p3)); break;
+        }
+    }
+    kernel.end_simd();
+    return x;
+}
+#endif
+
+template <typename Kernel>
+void fill_rows(const PatternTarget& target, Kernel& kernel, bool simd) {
+    size_t row_bytes = (size_t)target.width * bytes_per_pixel(target.format);
+    for (uint32_t y = 0; y < target.height; y++) {
+        uint8_t* row = target.data + (size_t)y * target.stride;
+        if (Kernel::ROW_INVARIANT && y > 0) {
+            memcpy(row, target.data, row_bytes);
+            continue;
+        }
+        kernel.begin_row(y);
+        uint32_t x = 0;
+#if PATTERN_SIMD
+        if (simd) x = fill_row_simd(row, target.width, target.format, kernel);
+#else
+        (void)simd;
+#endif
+        for (; x < target.width; x++) store_pixel(row, x, target.format, kernel.pixel(x));
+    }
+}
+
+void fill(const PatternTarget& target, TestPattern pattern, uint32_t color, uint32_t seed, bool simd) {
+    if (!target.data || target.width == 0 || target.height == 0) return;
+    color &= 0xFFFFFF;
+    switch (pattern) {
+        case TestPattern::GRADIENT: {
+            GradientKernel kernel(target, color);
+            fill_rows(target, kernel, simd);
+            break;
+        }
+        case TestPattern::CHECKERBOARD: {
+            CheckerKernel kernel(color);
+            fill_rows(target, kernel, simd);
+            break;
+        }
+        case TestPattern::ALPHA_RAMP: {
+            AlphaRampKernel kernel(target, color);
+            fill_rows(target, kernel, simd);
+            break;
+        }
+        case TestPattern::NOISE: {
+            NoiseKernel kernel(color, seed);
+            fill_rows(target, kernel, simd);
+            break;
+        }
+        default: {
+            SolidKernel kernel(color);
+            fill_rows(target, kernel, simd);
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+const char* pattern_name(TestPattern pattern) {
+    switch (pattern) {
+        case TestPattern::SOLID: return "solid";
+        case TestPattern::GRADIENT: return "gradient";
+        case TestPattern::CHECKERBOARD: return "checkerboard";
+        case TestPattern::ALPHA_RAMP: return "alpha_ramp";
+        case TestPattern::NOISE: return "noise";
+        default: return "unknown";
+    }
+}
+
+void pattern_fill(const PatternTarget& target, TestPattern pattern, uint32_t color, uint32_t seed) {
+    fill(target, pattern, color, seed, true);
+}
+
+void pattern_fill_scalar(const PatternTarget& target, TestPattern pattern, uint32_t color, uint32_t seed) {
+    fill(target, pattern, color, seed, false);
+}
+
+const char* pattern_fill_isa() {
+#if PATTERN_SSE2
+    return "SSE2";
+#elif PATTERN_NEON
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
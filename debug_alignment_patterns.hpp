@@ -0,0 +1,50 @@
+/*
+File:   debug_alignment_patterns.hpp
+Author: Will Jenkins
+Purpose: Canvas test patterns written straight into a pixel buffer, vectorized where available
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Set to 0 to build only the scalar generators (SSE2 on x86, NEON on ARM otherwise)
+#ifndef DEBUG_ALIGNMENT_PATTERN_SIMD
+#define DEBUG_ALIGNMENT_PATTERN_SIMD 1
+#endif
+
+// Pixel layouts, in CanvasBufferPool format order; all little-endian
+enum class PatternFormat : uint8_t {
+    RGB565,    // u16 rrrrrggggggbbbbb
+    ARGB8888,  // u32 0xAARRGGBB, straight alpha
+    L8,        // u8 luminance
+};
+
+enum class TestPattern : uint8_t {
+    SOLID,         // The color everywhere
+    GRADIENT,      // Diagonal, black at the top left to the color at the bottom right
+    CHECKERBOARD,  // 8 px cells of the color and the color at half brightness
+    ALPHA_RAMP,    // Alpha 0 to 255 left to right (over black in formats without alpha)
+    NOISE,         // The color at random per-pixel brightness
+    COUNT
+};
+
+struct PatternTarget {
+    uint8_t* data;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;  // Bytes per row, at least width * bytes per pixel
+    PatternFormat format;
+};
+
+const char* pattern_name(TestPattern pattern);
+
+// Fill target with pattern; color is 0xRRGGBB and seed varies the noise. Both write the
+// same pixels: pattern_fill runs 16 pixels per step on SSE2/NEON, pattern_fill_scalar
+// one at a time.
+void pattern_fill(const PatternTarget& target, TestPattern pattern, uint32_t color, uint32_t seed = 0);
+void pattern_fill_scalar(const PatternTarget& target, TestPattern pattern, uint32_t color, uint32_t seed = 0);
+
+// What pattern_fill runs on in this build: "SSE2", "NEON" or "scalar"
+const char* pattern_fill_isa();
@@ -0,0 +1,213 @@
+/*
+File:   debug_alignment_perf.cpp
+Author: Will Jenkins
+Purpose: Frame render/flush time, FPS and redrawn pixel strip in the panel header
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_clock.hpp"
+#include "debug_alignment_log.hpp"
+#include <algorithm>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// How often the strip takes in new frames and redraws. Its own redraw is a frame too,
+// so this bounds what the readout adds to the frames it measures.
+#ifndef DEBUG_ALIGNMENT_PERF_PERIOD
+#define DEBUG_ALIGNMENT_PERF_PERIOD 500
+#endif
+
+SpscRing<DebugAlignmentEnhanced::FrameSample, 128> DebugAlignmentEnhanced::frame_samples;
+DebugAlignmentEnhanced::FrameSample DebugAlignmentEnhanced::frame_history[PERF_HISTORY];
+uint32_t DebugAlignmentEnhanced::frame_history_count = 0;
+DebugAlignmentEnhanced::FrameTiming DebugAlignmentEnhanced::frame_timing;
+lv_display_t* DebugAlignmentEnhanced::perf_display = nullptr;
+lv_timer_t* DebugAlignmentEnhanced::perf_timer = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::perf_strip = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::perf_label = nullptr;
+uint32_t DebugAlignmentEnhanced::perf_last_update = 0;
+bool DebugAlignmentEnhanced::perf_self_refresh = false;
+
+namespace {
+
+constexpr int32_t SPARK_WIDTH = 180;  // PERF_HISTORY bars, 3 px apart
+constexpr uint32_t RENDER_COLOR = 0x3498DB;
+constexpr uint32_t FLUSH_COLOR = 0xE67E22;
+constexpr uint32_t BUDGET_COLOR = 0xE74C3C;
+
+// Bar height for a duration, at `scale` us per full strip height
+int32_t bar_height(uint32_t us, uint32_t scale, int32_t height) {
+    return (int32_t)((uint64_t)us * (uint64_t)height / scale);
+}
+
+}  // namespace
+
+// Sparkline on the left, averages since the last update on the right
+void DebugAlignmentEnhanced::create_perf_strip(lv_obj_t* parent) {
+    perf_strip = lv_obj_create(parent);
+    lv_obj_set_size(perf_strip, 490, 18);
+    lv_obj_align(perf_strip, LV_ALIGN_TOP_LEFT, 200, 38);
+    apply_style(perf_strip, PanelStyle::TRANSPARENT);
+    lv_obj_clear_flag(perf_strip, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(perf_strip, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(perf_strip, perf_strip_draw_event, LV_EVENT_DRAW_MAIN, nullptr);
+
+    perf_label = create_styled_label(perf_strip, "", PanelStyle::TEXT_SMALL);
+    lv_obj_align(perf_label, LV_ALIGN_LEFT_MID, SPARK_WIDTH + 10, 0);
+}
+
+// Frames are only timed while the panel is open
+void DebugAlignmentEnhanced::start_perf_hooks() {
+    if (perf_display || !parent_screen) return;
+    perf_display = lv_obj_get_display(parent_screen);
+    if (!perf_display) return;
+    frame_samples.clear();
+    frame_timing = FrameTiming();
+    lv_display_add_event_cb(perf_display, perf_display_event, LV_EVENT_RENDER_START, nullptr);
+    lv_display_add_event_cb(perf_display, perf_display_event, LV_EVENT_FLUSH_START, nullptr);
+    lv_display_add_event_cb(perf_display, perf_display_event, LV_EVENT_FLUSH_FINISH, nullptr);
+    lv_display_add_event_cb(perf_display, perf_display_event, LV_EVENT_RENDER_READY, nullptr);
+
+    perf_last_update = lv_tick_get();
+    perf_self_refresh = false;
+    if (!perf_timer) perf_timer = lv_timer_create(perf_timer_cb, DEBUG_ALIGNMENT_PERF_PERIOD, nullptr);
+}
+
+void DebugAlignmentEnhanced::stop_perf_hooks() {
+    if (perf_timer) {
+        lv_timer_delete(perf_timer);
+        perf_timer = nullptr;
+    }
+    if (!perf_display) return;
+    lv_display_remove_event_cb_with_user_data(perf_display, perf_display_event, nullptr);
+    perf_display = nullptr;
+}
+
+// Runs inside the refresh, so it only timestamps and pushes
+void DebugAlignmentEnhanced::perf_display_event(lv_event_t* e) {
+    FrameTiming& timing = frame_timing;
+    uint64_t now = DEBUG_ALIGNMENT_TIME_US();
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_RENDER_START:
+            timing = FrameTiming();
+            timing.rendering = true;
+            timing.render_begin_us = now;
+            break;
+        case LV_EVENT_FLUSH_START: {
+            timing.flush_begin_us = now;
+            const lv_area_t* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+            if (area) timing.pixels += lv_area_get_size(area);
+            break;
+        }
+        case LV_EVENT_FLUSH_FINISH:
+            if (timing.flush_begin_us) {
+                timing.flush_us += (uint32_t)(now - timing.flush_begin_us);
+                timing.flush_begin_us = 0;
+            }
+            break;
+        case LV_EVENT_RENDER_READY: {
+            if (!timing.rendering) break;
+            timing.rendering = false;
+            // A full ring means the strip is behind; that frame is simply not shown
+            FrameSample* sample = frame_samples.begin_push();
+            if (!sample) break;
+            uint32_t total = (uint32_t)(now - timing.render_begin_us);
+            sample->tick = lv_tick_get();
+            sample->flush_us = std::min(timing.flush_us, total);
+            sample->render_us = total - sample->flush_us;
+            sample->pixels = timing.pixels;
+            frame_samples.end_push();
+            break;
+        }
+        default: break;
+    }
+}
+
+void DebugAlignmentEnhanced::perf_timer_cb(lv_timer_t*) {
+    uint32_t taken = 0;
+    uint64_t render_us = 0;
+    uint64_t flush_us = 0;
+    uint64_t pixels = 0;
+    FrameSample sample;
+    while (frame_samples.pop(sample)) {
+        frame_history[frame_history_count % PERF_HISTORY] = sample;
+        frame_history_count++;
+        render_us += sample.render_us;
+        flush_us += sample.flush_us;
+        pixels += sample.pixels;
+        taken++;
+    }
+    uint32_t now = lv_tick_get();
+    uint32_t elapsed = std::max<uint32_t>(1, now - perf_last_update);
+    perf_last_update = now;
+
+    // Nothing new, or only the frame the strip's own last redraw caused: redrawing
+    // again would just keep the display busy measuring itself
+    if (taken == 0 || (taken == 1 && perf_self_refresh)) {
+        perf_self_refresh = false;
+        return;
+    }
+    if (!perf_strip || !perf_label) return;
+    uint32_t render_avg = (uint32_t)(render_us / taken);
+    uint32_t flush_avg = (uint32_t)(flush_us / taken);
+    lv_label_set_text_fmt(perf_label, "%u.%u ms render  %u.%u ms flush  %u fps  %u px/frame",
+                          (unsigned)(render_avg / 1000), (unsigned)(render_avg % 1000 / 100),
+                          (unsigned)(flush_avg / 1000), (unsigned)(flush_avg % 1000 / 100),
+                          (unsigned)((uint64_t)taken * 1000 / elapsed), (unsigned)(pixels / taken));
+    lv_obj_invalidate(perf_strip);
+    perf_self_refresh = true;
+}
+
+// One bar per frame, render at the bottom and flush stacked on it, newest on the right.
+// Scaled to the slowest frame shown but never below one refresh period, which is
+// marked as the frame budget.
+void DebugAlignmentEnhanced::perf_strip_draw_event(lv_event_t* e) {
+    uint32_t count = std::min<uint32_t>(frame_history_count, PERF_HISTORY);
+    if (count == 0) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(perf_strip, &coords);
+    int32_t height = lv_area_get_height(&coords);
+
+    const uint32_t budget_us = LV_DEF_REFR_PERIOD * 1000;
+    uint32_t scale = budget_us;
+    for (uint32_t i = 0; i < count; i++) {
+        const FrameSample& frame = frame_history[i];
+        scale = std::max(scale, frame.render_us + frame.flush_us);
+    }
+
+    lv_draw_rect_dsc_t bar;
+    lv_draw_rect_dsc_init(&bar);
+    bar.bg_opa = LV_OPA_COVER;
+    const int32_t pitch = SPARK_WIDTH / PERF_HISTORY;
+    for (uint32_t i = 0; i < count; i++) {
+        const FrameSample& frame = frame_history[(frame_history_count - count + i) % PERF_HISTORY];
+        lv_area_t area;
+        area.x1 = coords.x1 + SPARK_WIDTH - (int32_t)(count - i) * pitch;
+        area.x2 = area.x1 + pitch - 2;
+        int32_t render_h = bar_height(frame.render_us, scale, height);
+        int32_t flush_h = bar_height(frame.flush_us, scale, height);
+        area.y2 = coords.y2;
+        area.y1 = coords.y2 - std::max<int32_t>(1, render_h) + 1;
+        bar.bg_color = lv_color_hex(RENDER_COLOR);
+        lv_draw_rect(layer, &bar, &area);
+        if (flush_h > 0) {
+            area.y2 = area.y1 - 1;
+            area.y1 = area.y2 - flush_h + 1;
+            bar.bg_color = lv_color_hex(FLUSH_COLOR);
+            lv_draw_rect(layer, &bar, &area);
+        }
+    }
+
+    lv_draw_line_dsc_t line;
+    lv_draw_line_dsc_init(&line);
+    line.color = lv_color_hex(BUDGET_COLOR);
+    line.width = 1;
+    line.opa = LV_OPA_70;
+    line.p1.x = coords.x1;
+    line.p2.x = coords.x1 + SPARK_WIDTH - 1;
+    line.p1.y = line.p2.y = coords.y2 - bar_height(budget_us, scale, height);
+    lv_draw_line(layer, &line);
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT
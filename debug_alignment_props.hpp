@@ -0,0 +1,286 @@
+/*
+File:   debug_alignment_props.hpp
+Author: Will Jenkins
+Purpose: Per-type property records for spawned widgets
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+// One record per widget family. A spawned object stores only the record for its own
+// type inside a WidgetProps variant, so e.g. an LED no longer carries table or
+// message box fields.
+
+struct ArcProps {
+    int start_angle = 0;
+    int end_angle = 270;
+    int arc_width = 15;
+    int track_width = 5;
+    int value = 50;
+    int range_min = 0;
+    int range_max = 100;
+    int rotation = 0;
+    int pad = 0;
+    bool track_visible = true;
+    bool rounded_caps = false;
+};
+
+// Bar and Slider
+struct BarProps {
+    int min_value = 0;
+    int max_value = 100;
+    int current_value = 50;
+    int indicator_width = 20;
+    int bar_mode = 0; // 0=normal, 1=range
+    bool horizontal = true;
+};
+
+// Button, Switch, Checkbox and LED
+struct ToggleProps {
+    bool state = false;
+    bool checked = false;
+    bool disabled = false;
+    uint8_t color_index = 0;  // LED color cycling
+    int brightness = 255;     // LED
+    int pad_all = 5;
+    int anim_time = 200;      // Switch
+    int knob_pad = 2;         // Switch
+};
+
+struct CanvasProps {
+    int canvas_width = 200;   // Buffer size; follows the transform size on Recreate
+    int canvas_height = 150;
+    int fill_color = 0x333333;
+    bool test_drawing = false; // Showing test_pattern instead of a plain fill
+    uint8_t color_format = 0; // CanvasBufferPool::format_at() index: RGB565, ARGB8888, L8
+    uint8_t test_pattern = 1; // TestPattern, drawn in fill_color
+};
+
+struct ChartProps {
+    int chart_points = 10;
+    int chart_type = 0; // 0=line, 1=bar, 2=scatter
+    int y_min = 0;
+    int y_max = 100;
+    int h_div_lines = 5;
+    int v_div_lines = 5;
+    int update_mode = 0; // 0=circular, 1=shift
+    int series_count = 1;
+    int feed_rate = 0;   // Synthetic samples per second into every series, 0 = off
+    int decimate = 0;    // 1 = fed line charts keep a min/max pair per pixel column
+};
+
+struct TableProps {
+    int table_rows = 3;
+    int table_cols = 3;
+    int selected_row = 0;
+    int selected_col = 0;
+    int col_width = 80;
+    int cell_align = 0; // 0=left, 1=center, 2=right
+};
+
+struct SpinnerProps {
+    int spinner_speed = 1000;
+    int spinner_arc_length = 60;
+};
+
+struct SpinboxProps {
+    int spinbox_min = 0;
+    int spinbox_max = 100;
+    int spinbox_step = 1;
+    int spinbox_digits = 4;
+    int spinbox_sep_pos = 2;
+    bool spinbox_rollover = false;
+};
+
+// Largest record (two strings); bounds sizeof(WidgetProps)
+struct MsgBoxProps {
+    std::string msgbox_title = "Title";
+    std::string msgbox_text = "Message";
+    int msgbox_button_count = 2;
+    bool msgbox_modal = false;
+};
+
+struct PieProps {
+    int pie_segments = 4;
+    int pie_start_angle = 0;
+    int pie_gap_angle = 2;
+    int pie_donut_thickness = 0; // 0 = full pie
+    bool pie_normalize = true;
+    bool pie_antialias = true;
+};
+
+using WidgetProps = std::variant<ArcProps, BarProps, ToggleProps, CanvasProps, ChartProps,
+                                 TableProps, SpinnerProps, SpinboxProps, MsgBoxProps, PieProps>;
+
+// One member of a props record. Journal deltas and scene files address members by their
+// index in the record's table, never through its in-memory layout, so padding, packed
+// bools and byte order stay out of both. New members go at the end of their table.
+struct PropsField {
+    uint16_t offset;
+    uint8_t size;  // 4 for int, 1 for bool and uint8_t
+    bool flag;     // bool member: only 0 and 1 are read and written
+};
+
+template <typename T>
+constexpr PropsField props_field(size_t offset) {
+    static_assert(std::is_same<T, int>::value || std::is_same<T, bool>::value || std::is_same<T, uint8_t>::value,
+                  "props members in the table must be int, bool or uint8_t");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 4, "props members are 8 or 32 bits wide");
+    return PropsField{(uint16_t)offset, (uint8_t)sizeof(T), std::is_same<T, bool>::value};
+}
+
+#define DA_PROPS_FIELD(Record, member) props_field<decltype(Record::member)>(offsetof(Record, member))
+
+// Members of each record, in journal and file order. Strings are not in the tables.
+template <typename P> struct PropsFields;
+
+template <> struct PropsFields<ArcProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(ArcProps, start_angle), DA_PROPS_FIELD(ArcProps, end_angle),
+        DA_PROPS_FIELD(ArcProps, arc_width),   DA_PROPS_FIELD(ArcProps, track_width),
+        DA_PROPS_FIELD(ArcProps, value),       DA_PROPS_FIELD(ArcProps, range_min),
+        DA_PROPS_FIELD(ArcProps, range_max),   DA_PROPS_FIELD(ArcProps, rotation),
+        DA_PROPS_FIELD(ArcProps, pad),         DA_PROPS_FIELD(ArcProps, track_visible),
+        DA_PROPS_FIELD(ArcProps, rounded_caps),
+    };
+};
+
+template <> struct PropsFields<BarProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(BarProps, min_value),       DA_PROPS_FIELD(BarProps, max_value),
+        DA_PROPS_FIELD(BarProps, current_value),   DA_PROPS_FIELD(BarProps, indicator_width),
+        DA_PROPS_FIELD(BarProps, bar_mode),        DA_PROPS_FIELD(BarProps, horizontal),
+    };
+};
+
+template <> struct PropsFields<ToggleProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(ToggleProps, state),      DA_PROPS_FIELD(ToggleProps, checked),
+        DA_PROPS_FIELD(ToggleProps, disabled),   DA_PROPS_FIELD(ToggleProps, color_index),
+        DA_PROPS_FIELD(ToggleProps, brightness), DA_PROPS_FIELD(ToggleProps, pad_all),
+        DA_PROPS_FIELD(ToggleProps, anim_time),  DA_PROPS_FIELD(ToggleProps, knob_pad),
+    };
+};
+
+template <> struct PropsFields<CanvasProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(CanvasProps, canvas_width),  DA_PROPS_FIELD(CanvasProps, canvas_height),
+        DA_PROPS_FIELD(CanvasProps, fill_color),    DA_PROPS_FIELD(CanvasProps, test_drawing),
+        DA_PROPS_FIELD(CanvasProps, color_format),  DA_PROPS_FIELD(CanvasProps, test_pattern),
+    };
+};
+
+template <> struct PropsFields<ChartProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(ChartProps, chart_points), DA_PROPS_FIELD(ChartProps, chart_type),
+        DA_PROPS_FIELD(ChartProps, y_min),        DA_PROPS_FIELD(ChartProps, y_max),
+        DA_PROPS_FIELD(ChartProps, h_div_lines),  DA_PROPS_FIELD(ChartProps, v_div_lines),
+        DA_PROPS_FIELD(ChartProps, update_mode),  DA_PROPS_FIELD(ChartProps, series_count),
+        DA_PROPS_FIELD(ChartProps, feed_rate),    DA_PROPS_FIELD(ChartProps, decimate),
+    };
+};
+
+template <> struct PropsFields<TableProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(TableProps, table_rows),   DA_PROPS_FIELD(TableProps, table_cols),
+        DA_PROPS_FIELD(TableProps, selected_row), DA_PROPS_FIELD(TableProps, selected_col),
+        DA_PROPS_FIELD(TableProps, col_width),    DA_PROPS_FIELD(TableProps, cell_align),
+    };
+};
+
+template <> struct PropsFields<SpinnerProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(SpinnerProps, spinner_speed), DA_PROPS_FIELD(SpinnerProps, spinner_arc_length),
+    };
+};
+
+template <> struct PropsFields<SpinboxProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(SpinboxProps, spinbox_min),    DA_PROPS_FIELD(SpinboxProps, spinbox_max),
+        DA_PROPS_FIELD(SpinboxProps, spinbox_step),   DA_PROPS_FIELD(SpinboxProps, spinbox_digits),
+        DA_PROPS_FIELD(SpinboxProps, spinbox_sep_pos), DA_PROPS_FIELD(SpinboxProps, spinbox_rollover),
+    };
+};
+
+// The title and text are saved separately; only the scalars are journaled
+template <> struct PropsFields<MsgBoxProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(MsgBoxProps, msgbox_button_count), DA_PROPS_FIELD(MsgBoxProps, msgbox_modal),
+    };
+};
+
+template <> struct PropsFields<PieProps> {
+    static constexpr PropsField fields[] = {
+        DA_PROPS_FIELD(PieProps, pie_segments),        DA_PROPS_FIELD(PieProps, pie_start_angle),
+        DA_PROPS_FIELD(PieProps, pie_gap_angle),       DA_PROPS_FIELD(PieProps, pie_donut_thickness),
+        DA_PROPS_FIELD(PieProps, pie_normalize),       DA_PROPS_FIELD(PieProps, pie_antialias),
+    };
+};
+
+// Largest table; bounds snapshots of a record's members
+constexpr int PROPS_MAX_FIELDS = 16;
+
+template <typename P>
+constexpr int props_field_count() {
+    constexpr int count = (int)(sizeof(PropsFields<P>::fields) / sizeof(PropsField));
+    static_assert(count <= PROPS_MAX_FIELDS, "props record has too many members to journal");
+    return count;
+}
+
+inline int32_t get_props_field(const void* record, const PropsField& field) {
+    const char* p = static_cast<const char*>(record) + field.offset;
+    if (field.size == 4) {
+        int32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    if (field.flag) {
+        bool value;
+        memcpy(&value, p, sizeof(value));
+        return value ? 1 : 0;
+    }
+    return (int32_t)*reinterpret_cast<const uint8_t*>(p);
+}
+
+inline void set_props_field(void* record, const PropsField& field, int32_t value) {
+    char* p = static_cast<char*>(record) + field.offset;
+    if (field.size == 4) {
+        memcpy(p, &value, sizeof(value));
+    } else if (field.flag) {
+        bool flag = value != 0;
+        memcpy(p, &flag, sizeof(flag));
+    } else {
+        *reinterpret_cast<uint8_t*>(p) = (uint8_t)value;
+    }
+}
+
+inline int props_field_count(const WidgetProps& props) {
+    return std::visit([](const auto& record) { return props_field_count<std::decay_t<decltype(record)>>(); }, props);
+}
+
+// Copies up to max_fields member values out in table order; returns how many
+inline int read_props_fields(const WidgetProps& props, int32_t* out, int max_fields) {
+    return std::visit([&](const auto& record) {
+        using P = std::decay_t<decltype(record)>;
+        int count = std::min(props_field_count<P>(), max_fields);
+        for (int i = 0; i < count; i++) out[i] = get_props_field(&record, PropsFields<P>::fields[i]);
+        return count;
+    }, props);
+}
+
+inline bool write_props_field(WidgetProps& props, int index, int32_t value) {
+    return std::visit([&](auto& record) {
+        using P = std::decay_t<decltype(record)>;
+        if (index < 0 || index >= props_field_count<P>()) return false;
+        set_props_field(&record, PropsFields<P>::fields[index], value);
+        return true;
+    }, props);
+}
+
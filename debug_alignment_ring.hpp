@@ -0,0 +1,125 @@
+/*
+File:   debug_alignment_ring.hpp
+Author: Will Jenkins
+Purpose: Fixed-capacity lock-free ring buffers
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// One producer and one consumer, each on its own thread (or both on the LVGL thread).
+// Capacity must be a power of two; indices run freely and are masked on access.
+// Slots can be filled/read in place with begin_push()/end_push() and front()/pop_front()
+// so large records are not copied twice.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr size_t capacity() { return N; }
+
+    // Producer: slot to fill, or nullptr when full. Publish it with end_push().
+    T* begin_push() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) return nullptr;
+        return &items_[head & (N - 1)];
+    }
+    void end_push() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    bool push(const T& item) {
+        T* slot = begin_push();
+        if (!slot) return false;
+        *slot = item;
+        end_push();
+        return true;
+    }
+
+    // Consumer: oldest item, or nullptr when empty. Release it with pop_front().
+    const T* front() const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return nullptr;
+        return &items_[tail & (N - 1)];
+    }
+    void pop_front() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    bool pop(T& out) {
+        const T* item = front();
+        if (!item) return false;
+        out = *item;
+        pop_front();
+        return true;
+    }
+
+    // Approximate when called from the side that is not currently writing
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    void clear() { tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+private:
+    T items_[N];
+    std::atomic<size_t> head_{0};  // Next slot the producer writes
+    std::atomic<size_t> tail_{0};  // Next slot the consumer reads
+};
+
+// One producer that never waits: once full, each push overwrites the oldest item, so
+// the ring always holds the newest N. Readers copy items out at any time; each slot
+// carries the sequence number of the push that filled it, and a slot overwritten
+// while it was being copied is skipped rather than returned torn.
+template <typename T, size_t N>
+class LatestRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "LatestRing capacity must be a power of two");
+
+public:
+    static constexpr size_t capacity() { return N; }
+
+    void push(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[head & (N - 1)];
+        slot.seq.store(0, std::memory_order_relaxed);  // Being written
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.item = item;
+        slot.seq.store(head + 1, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // fn(item) for each item still held, oldest first
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = head > N ? head - N : 0; i < head; i++) {
+            const Slot& slot = slots_[i & (N - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != i + 1) continue;
+            T copy = slot.item;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != i + 1) continue;
+            fn(copy);
+        }
+    }
+
+    // Items ever pushed; the ring holds the last min(pushed(), N) of them
+    uint64_t pushed() const { return head_.load(std::memory_order_acquire); }
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire);
+        return head < N ? head : N;
+    }
+    // Only while nothing pushes
+    void clear() {
+        for (Slot& slot : slots_) slot.seq.store(0, std::memory_order_relaxed);
+        head_.store(0, std::memory_order_release);
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq{0};  // Push number + 1 of the item in the slot, 0 while empty or being written
+        T item;
+    };
+    Slot slots_[N];
+    std::atomic<size_t> head_{0};  // Pushes so far
+};
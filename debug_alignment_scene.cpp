@@ -0,0 +1,198 @@
+/*
+File:   debug_alignment_scene.cpp
+Author: Will Jenkins
+Purpose: Compact versioned binary scene format for saving and reloading spawned objects
+*/
+
+#include "debug_alignment_scene.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint8_t SCENE_MAGIC[4] = {'D', 'A', 'S', 'C'};
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t OBJECT_FIXED_SIZE = 8 + 4 * (SceneObject::TRANSFORM_FIELDS + SceneObject::STYLE_FIELDS);
+
+void put_u16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 24));
+}
+
+uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void put_string(std::vector<uint8_t>& out, const std::string& s) {
+    uint16_t length = (uint16_t)std::min<size_t>(s.size(), UINT16_MAX);
+    put_u16(out, length);
+    out.insert(out.end(), s.begin(), s.begin() + length);
+}
+
+}  // namespace
+
+void scene_append_header(std::vector<uint8_t>& out, uint32_t count) {
+    out.insert(out.end(), SCENE_MAGIC, SCENE_MAGIC + 4);
+    put_u16(out, DEBUG_ALIGNMENT_SCENE_VERSION);
+    put_u16(out, 0);
+    put_u32(out, count);
+    put_u32(out, 0);
+}
+
+void scene_append_object(std::vector<uint8_t>& out, const SceneObject& object, const WidgetProps& props) {
+    int32_t fields[PROPS_MAX_FIELDS];
+    int field_count = read_props_fields(props, fields, PROPS_MAX_FIELDS);
+    const MsgBoxProps* msgbox = std::get_if<MsgBoxProps>(&props);
+
+    out.push_back(object.type);
+    out.push_back((uint8_t)props.index());
+    out.push_back((uint8_t)field_count);
+    out.push_back(msgbox ? 2 : 0);
+    put_u32(out, object.serial);
+    for (int32_t v : object.transform) put_u32(out, (uint32_t)v);
+    for (int32_t v : object.style) put_u32(out, (uint32_t)v);
+    for (int i = 0; i < field_count; i++) put_u32(out, (uint32_t)fields[i]);
+    if (msgbox) {
+        put_string(out, msgbox->msgbox_title);
+        put_string(out, msgbox->msgbox_text);
+    }
+}
+
+SceneReader::SceneReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+    if (!data || size < HEADER_SIZE || memcmp(data, SCENE_MAGIC, 4) != 0) return;
+    if (get_u16(data + 4) != DEBUG_ALIGNMENT_SCENE_VERSION) return;
+    count_ = get_u32(data + 8);
+    offset_ = HEADER_SIZE;
+    valid_ = true;
+}
+
+bool SceneReader::next(SceneObject& out) {
+    if (!valid_ || truncated_ || read_ >= count_) return false;
+    if (size_ - offset_ < OBJECT_FIXED_SIZE) {
+        truncated_ = true;
+        return false;
+    }
+    const uint8_t* p = data_ + offset_;
+    out.type = p[0];
+    record_ = p[1];
+    fields_ = p[2];
+    strings_ = p[3];
+    out.serial = get_u32(p + 4);
+    p += 8;
+    for (int32_t& v : out.transform) {
+        v = (int32_t)get_u32(p);
+        p += 4;
+    }
+    for (int32_t& v : out.style) {
+        v = (int32_t)get_u32(p);
+        p += 4;
+    }
+
+    // Props fields and strings: check the whole tail is inside the buffer up front
+    size_t end = offset_ + OBJECT_FIXED_SIZE + (size_t)fields_ * 4;
+    for (uint8_t i = 0; i < strings_ && end <= size_; i++) {
+        end = size_ - end < 2 ? size_ + 1 : end + 2 + get_u16(data_ + end);
+    }
+    if (end > size_) {
+        truncated_ = true;
+        return false;
+    }
+    props_ = p;
+    offset_ = end;
+    read_++;
+    return true;
+}
+
+// Fields past the end of the stored ones keep their defaults; stored fields the record
+// no longer has are skipped
+bool SceneReader::read_props(WidgetProps& props) const {
+    if (!props_ || record_ != props.index()) return false;
+    return std::visit([&](auto& record) {
+        using P = std::decay_t<decltype(record)>;
+        constexpr bool has_strings = std::is_same<P, MsgBoxProps>::value;
+        if (strings_ != (has_strings ? 2 : 0)) return false;
+        int count = std::min<int>(fields_, props_field_count<P>());
+        for (int i = 0; i < count; i++) {
+            set_props_field(&record, PropsFields<P>::fields[i], (int32_t)get_u32(props_ + i * 4));
+        }
+        if constexpr (has_strings) {
+            const uint8_t* s = props_ + (size_t)fields_ * 4;
+            uint16_t length = get_u16(s);
+            record.msgbox_title.assign((const char*)s + 2, length);
+            s += 2 + length;
+            length = get_u16(s);
+            record.msgbox_text.assign((const char*)s + 2, length);
+        }
+        return true;
+    }, props);
+}
+
+bool SceneFile::open(const char* path) {
+    close();
+#if defined(__linux__)
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (map == MAP_FAILED) return false;
+    data_ = (const uint8_t*)map;
+    size_ = (size_t)st.st_size;
+    mapped_ = true;
+    return true;
+#else
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    uint8_t chunk[4096];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer_.insert(buffer_.end(), chunk, chunk + got);
+    }
+    fclose(file);
+    if (buffer_.empty()) return false;
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+#endif
+}
+
+void SceneFile::close() {
+#if defined(__linux__)
+    if (mapped_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+}
+
+bool scene_write_file(const char* path, const std::vector<uint8_t>& bytes) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
@@ -0,0 +1,95 @@
+/*
+File:   debug_alignment_scene.hpp
+Author: Will Jenkins
+Purpose: Compact versioned binary scene format for saving and reloading spawned objects
+*/
+
+#pragma once
+
+#include "debug_alignment_props.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// File layout, all integers little-endian:
+//   header  "DASC" | u16 version | u16 reserved | u32 object count | u32 reserved
+//   object  u8 type | u8 props record | u8 props fields | u8 strings | u32 serial
+//           i32 transform[6] | i32 style[4] | i32 props[props fields]
+//           strings x (u16 length | bytes)
+// Objects are stored back to front, so instantiating them in file order restores the
+// stacking. Props are stored one i32 per member in PropsFields table order, whatever
+// the member's C++ type, so a member appended to a table loads as its default from
+// older files and reordering or repacking a record does not change the file. Only
+// removing or reordering table entries needs a version bump. A record of another type
+// than the loader expects is skipped and the object keeps its default props.
+#define DEBUG_ALIGNMENT_SCENE_VERSION 1
+
+struct SceneObject {
+    static constexpr int TRANSFORM_FIELDS = 6;  // x, y, rotation, width, height, pad
+    static constexpr int STYLE_FIELDS = 4;      // border width, radius, opa, hidden
+
+    uint32_t serial = 0;
+    uint8_t type = 0;
+    int32_t transform[TRANSFORM_FIELDS] = {};
+    int32_t style[STYLE_FIELDS] = {};
+};
+
+void scene_append_header(std::vector<uint8_t>& out, uint32_t count);
+void scene_append_object(std::vector<uint8_t>& out, const SceneObject& object, const WidgetProps& props);
+
+// Walks an encoded scene in place; nothing is copied out of the buffer except what
+// next() and read_props() hand back.
+class SceneReader {
+public:
+    SceneReader(const uint8_t* data, size_t size);
+
+    bool valid() const { return valid_; }
+    uint32_t count() const { return count_; }
+
+    // Fixed part of the next object. False at the end or on a truncated record
+    // (truncated() tells the two apart).
+    bool next(SceneObject& out);
+    bool truncated() const { return truncated_; }
+
+    // Props of the object last returned by next(), decoded into `props`, which must
+    // already hold the default record for its type. False if the stored record does
+    // not fit that record; `props` is left untouched.
+    bool read_props(WidgetProps& props) const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+    uint32_t count_ = 0;
+    uint32_t read_ = 0;
+    bool valid_ = false;
+    bool truncated_ = false;
+
+    // Span of the current object's props
+    uint8_t record_ = 0;
+    uint8_t fields_ = 0;
+    uint8_t strings_ = 0;
+    const uint8_t* props_ = nullptr;
+};
+
+// Read-only view of a whole file: memory-mapped on Linux, read into memory elsewhere
+class SceneFile {
+public:
+    SceneFile() = default;
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+    ~SceneFile() { close(); }
+
+    bool open(const char* path);
+    void close();
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint8_t> buffer_;
+};
+
+bool scene_write_file(const char* path, const std::vector<uint8_t>& bytes);
@@ -0,0 +1,116 @@
+/*
+File:   debug_alignment_slot_map.hpp
+Author: Will Jenkins
+Purpose: Generational slot map giving spawned objects stable O(1) handles
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Stable reference to an item in a SlotMap. A handle keeps resolving to the same item
+// until that item is erased; after that it resolves to nothing, even once the slot has
+// been reused (the generation no longer matches).
+struct SlotHandle {
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    uint32_t slot = INVALID_SLOT;
+    uint32_t generation = 0;
+
+    bool valid() const { return slot != INVALID_SLOT; }
+    bool operator==(const SlotHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Items live contiguously in a dense array (cheap iteration, positions 0..size()-1);
+// a sparse slot table maps handles to dense positions. Insert and lookup are O(1).
+// Erase closes the hole by shifting the later items down one position, so items stay
+// in insertion order. That makes erase O(n), which is fine at overlay object counts.
+template <typename T>
+class SlotMap {
+public:
+    SlotHandle insert(T value) {
+        uint32_t slot;
+        if (free_head_ != SlotHandle::INVALID_SLOT) {
+            slot = free_head_;
+            free_head_ = slots_[slot].dense;
+        } else {
+            slot = (uint32_t)slots_.size();
+            slots_.push_back(Slot());
+        }
+        slots_[slot].dense = (uint32_t)items_.size();
+        items_.push_back(std::move(value));
+        dense_to_slot_.push_back(slot);
+        return SlotHandle{slot, slots_[slot].generation};
+    }
+
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) return false;
+        uint32_t dense = slots_[handle.slot].dense;
+        items_.erase(items_.begin() + dense);
+        dense_to_slot_.erase(dense_to_slot_.begin() + dense);
+        for (uint32_t i = dense; i < (uint32_t)dense_to_slot_.size(); i++) {
+            slots_[dense_to_slot_[i]].dense = i;
+        }
+
+        // Retire the slot: bump the generation so old handles stop resolving
+        Slot& retired = slots_[handle.slot];
+        retired.generation++;
+        retired.dense = free_head_;
+        free_head_ = handle.slot;
+        return true;
+    }
+
+    bool contains(SlotHandle handle) const {
+        return handle.slot < slots_.size() && slots_[handle.slot].generation == handle.generation &&
+               slots_[handle.slot].dense < items_.size() && dense_to_slot_[slots_[handle.slot].dense] == handle.slot;
+    }
+
+    T* get(SlotHandle handle) { return contains(handle) ? &items_[slots_[handle.slot].dense] : nullptr; }
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &items_[slots_[handle.slot].dense] : nullptr;
+    }
+
+    // Dense position of a live handle, -1 otherwise
+    int position_of(SlotHandle handle) const { return contains(handle) ? (int)slots_[handle.slot].dense : -1; }
+    SlotHandle handle_at(int position) const {
+        if (position < 0 || position >= (int)items_.size()) return SlotHandle();
+        uint32_t slot = dense_to_slot_[position];
+        return SlotHandle{slot, slots_[slot].generation};
+    }
+    T& at(int position) { return items_[position]; }
+    const T& at(int position) const { return items_[position]; }
+
+    int size() const { return (int)items_.size(); }
+    bool empty() const { return items_.empty(); }
+
+    // Drops every item; slots stay retired so no outstanding handle resolves again
+    void clear() {
+        for (uint32_t slot : dense_to_slot_) {
+            slots_[slot].generation++;
+            slots_[slot].dense = free_head_;
+            free_head_ = slot;
+        }
+        items_.clear();
+        dense_to_slot_.clear();
+    }
+
+    typename std::vector<T>::iterator begin() { return items_.begin(); }
+    typename std::vector<T>::iterator end() { return items_.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items_.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;       // Position in items_ when live, next free slot when free
+        uint32_t generation = 0;  // Bumped on erase
+    };
+    std::vector<Slot> slots_;
+    std::vector<T> items_;
+    std::vector<uint32_t> dense_to_slot_;
+    uint32_t free_head_ = SlotHandle::INVALID_SLOT;
+};
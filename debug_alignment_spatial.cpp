@@ -0,0 +1,179 @@
+/*
+File:   debug_alignment_spatial.cpp
+Author: Will Jenkins
+Purpose: Uniform-grid spatial index over spawned object bounding boxes
+*/
+
+#include "debug_alignment_spatial.hpp"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(int32_t cell_size) : cell_size_(cell_size > 0 ? cell_size : DEFAULT_CELL_SIZE) {
+    cells_.resize(1);
+}
+
+void SpatialGrid::reset(int32_t width, int32_t height) {
+    for (auto& cell : cells_) cell.clear();
+    cols_ = std::max<int32_t>(1, (width + cell_size_ - 1) / cell_size_);
+    rows_ = std::max<int32_t>(1, (height + cell_size_ - 1) / cell_size_);
+    cells_.assign((size_t)cols_ * rows_, std::vector<uint32_t>());
+    for (uint32_t slot = 0; slot < entries_.size(); slot++) {
+        Entry& entry = entries_[slot];
+        if (!entry.live) continue;
+        cell_range(entry.box, entry.cx1, entry.cy1, entry.cx2, entry.cy2);
+        link(slot);
+    }
+}
+
+void SpatialGrid::cell_range(const lv_area_t& box, int32_t& cx1, int32_t& cy1, int32_t& cx2,
+                             int32_t& cy2) const {
+    auto cell_of = [this](int32_t v, int32_t count) {
+        int32_t c = v < 0 ? 0 : v / cell_size_;
+        return c < count ? c : count - 1;
+    };
+    cx1 = cell_of(box.x1, cols_);
+    cx2 = cell_of(box.x2, cols_);
+    cy1 = cell_of(box.y1, rows_);
+    cy2 = cell_of(box.y2, rows_);
+}
+
+void SpatialGrid::link(uint32_t slot) {
+    const Entry& entry = entries_[slot];
+    for (int32_t cy = entry.cy1; cy <= entry.cy2; cy++) {
+        for (int32_t cx = entry.cx1; cx <= entry.cx2; cx++) {
+            cells_[(size_t)cy * cols_ + cx].push_back(slot);
+        }
+    }
+}
+
+void SpatialGrid::unlink(uint32_t slot) {
+    const Entry& entry = entries_[slot];
+    for (int32_t cy = entry.cy1; cy <= entry.cy2; cy++) {
+        for (int32_t cx = entry.cx1; cx <= entry.cx2; cx++) {
+            std::vector<uint32_t>& cell = cells_[(size_t)cy * cols_ + cx];
+            auto it = std::find(cell.begin(), cell.end(), slot);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialGrid::update(SlotHandle id, const lv_area_t& box) {
+    if (!id.valid()) return;
+    if (id.slot >= entries_.size()) {
+        entries_.resize(id.slot + 1);
+        seen_.resize(id.slot + 1, 0);
+    }
+    Entry& entry = entries_[id.slot];
+    int32_t cx1, cy1, cx2, cy2;
+    cell_range(box, cx1, cy1, cx2, cy2);
+
+    if (entry.live) {
+        if (cx1 == entry.cx1 && cy1 == entry.cy1 && cx2 == entry.cx2 && cy2 == entry.cy2) {
+            // Small nudges usually stay inside the same cells: no re-bucketing
+            entry.id = id;
+            entry.box = box;
+            return;
+        }
+        unlink(id.slot);
+    } else {
+        count_++;
+    }
+    entry.id = id;
+    entry.box = box;
+    entry.cx1 = cx1;
+    entry.cy1 = cy1;
+    entry.cx2 = cx2;
+    entry.cy2 = cy2;
+    entry.live = true;
+    link(id.slot);
+}
+
+void SpatialGrid::remove(SlotHandle id) {
+    if (id.slot >= entries_.size()) return;
+    Entry& entry = entries_[id.slot];
+    if (!entry.live || entry.id != id) return;
+    unlink(id.slot);
+    entry.live = false;
+    count_--;
+}
+
+void SpatialGrid::clear() {
+    for (auto& cell : cells_) cell.clear();
+    entries_.clear();
+    seen_.clear();
+    count_ = 0;
+}
+
+// Calls fn(entry) once for every live entry bucketed in the cells under area
+template <typename Fn>
+void SpatialGrid::visit(const lv_area_t& area, Fn&& fn) const {
+    if (count_ == 0) return;
+    if (++stamp_ == 0) {
+        // Wrapped: old stamps could collide with the new one
+        std::fill(seen_.begin(), seen_.end(), 0);
+        stamp_ = 1;
+    }
+    int32_t cx1, cy1, cx2, cy2;
+    cell_range(area, cx1, cy1, cx2, cy2);
+    for (int32_t cy = cy1; cy <= cy2; cy++) {
+        for (int32_t cx = cx1; cx <= cx2; cx++) {
+            for (uint32_t slot : cells_[(size_t)cy * cols_ + cx]) {
+                if (seen_[slot] == stamp_) continue;
+                seen_[slot] = stamp_;
+                fn(entries_[slot]);
+            }
+        }
+    }
+}
+
+void SpatialGrid::query_point(int32_t x, int32_t y, std::vector<SlotHandle>& out) const {
+    lv_area_t area = {x, y, x, y};
+    visit(area, [&](const Entry& entry) {
+        if (x >= entry.box.x1 && x <= entry.box.x2 && y >= entry.box.y1 && y <= entry.box.y2) {
+            out.push_back(entry.id);
+        }
+    });
+}
+
+void SpatialGrid::query_rect(const lv_area_t& area, std::vector<SlotHandle>& out) const {
+    visit(area, [&](const Entry& entry) {
+        if (entry.box.x1 <= area.x2 && entry.box.x2 >= area.x1 && entry.box.y1 <= area.y2 &&
+            entry.box.y2 >= area.y1) {
+            out.push_back(entry.id);
+        }
+    });
+}
+
+SlotHandle SpatialGrid::nearest_edge(int32_t x, int32_t y, int32_t max_distance, SlotHandle exclude,
+                                     int32_t* distance) const {
+    SlotHandle best;
+    int32_t best_distance = max_distance + 1;
+    auto edge_distance = [x, y](const lv_area_t& box) {
+        int32_t dx = std::max({box.x1 - x, x - box.x2, (int32_t)0});
+        int32_t dy = std::max({box.y1 - y, y - box.y2, (int32_t)0});
+        if (dx || dy) return std::max(dx, dy);
+        return std::min({x - box.x1, box.x2 - x, y - box.y1, box.y2 - y});
+    };
+
+    // Grow a square window around the point. Any box with a boundary within `radius`
+    // overlaps the window, so the search can stop once the best hit is inside it.
+    int32_t radius = std::min(cell_size_, max_distance);
+    while (true) {
+        lv_area_t window = {x - radius, y - radius, x + radius, y + radius};
+        visit(window, [&](const Entry& entry) {
+            if (entry.id == exclude) return;
+            int32_t d = edge_distance(entry.box);
+            if (d < best_distance) {
+                best_distance = d;
+                best = entry.id;
+            }
+        });
+        if (best_distance <= radius || radius >= max_distance) break;
+        radius = std::min(radius * 2, max_distance);
+    }
+
+    if (best.valid() && distance) *distance = best_distance;
+    return best;
+}
@@ -0,0 +1,64 @@
+/*
+File:   debug_alignment_spatial.hpp
+Author: Will Jenkins
+Purpose: Uniform-grid spatial index over spawned object bounding boxes
+*/
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include "debug_alignment_slot_map.hpp"
+#include <cstdint>
+#include <vector>
+
+// Buckets each box into every fixed-size cell it overlaps, so point, rectangle and
+// nearest-edge queries only visit the cells around the query instead of every object.
+// Boxes are inclusive like lv_area_t. Boxes outside the bounds (objects dragged off
+// screen) are clamped into the border cells, so they stay findable.
+class SpatialGrid {
+public:
+    static constexpr int32_t DEFAULT_CELL_SIZE = 64;
+
+    explicit SpatialGrid(int32_t cell_size = DEFAULT_CELL_SIZE);
+
+    // Resize the covered area (normally the screen); re-buckets anything already indexed
+    void reset(int32_t width, int32_t height);
+
+    // Add an item or move it to a new box. Cheap when the box stays in the same cells.
+    void update(SlotHandle id, const lv_area_t& box);
+    void remove(SlotHandle id);
+    void clear();
+    int size() const { return count_; }
+
+    // Items whose box contains the point / overlaps the area, each reported once
+    void query_point(int32_t x, int32_t y, std::vector<SlotHandle>& out) const;
+    void query_rect(const lv_area_t& area, std::vector<SlotHandle>& out) const;
+
+    // Item whose box boundary is closest to (x, y) within max_distance, skipping
+    // `exclude`. Distance is Chebyshev: max(dx, dy) outside a box, distance to the
+    // nearest side inside it. Returns an invalid handle if nothing is in range.
+    SlotHandle nearest_edge(int32_t x, int32_t y, int32_t max_distance, SlotHandle exclude = SlotHandle(),
+                            int32_t* distance = nullptr) const;
+
+private:
+    struct Entry {
+        SlotHandle id;
+        lv_area_t box;
+        int32_t cx1, cy1, cx2, cy2;  // Cell range the box is bucketed into
+        bool live = false;
+    };
+
+    void cell_range(const lv_area_t& box, int32_t& cx1, int32_t& cy1, int32_t& cx2, int32_t& cy2) const;
+    void link(uint32_t slot);
+    void unlink(uint32_t slot);
+    template <typename Fn> void visit(const lv_area_t& area, Fn&& fn) const;
+
+    int32_t cell_size_;
+    int32_t cols_ = 1;
+    int32_t rows_ = 1;
+    int count_ = 0;
+    std::vector<Entry> entries_;                // Indexed by SlotHandle::slot
+    std::vector<std::vector<uint32_t>> cells_;  // Slots bucketed per cell, row-major
+    mutable std::vector<uint32_t> seen_;        // Per-slot query stamp for de-duplication
+    mutable uint32_t stamp_ = 0;
+};
@@ -0,0 +1,331 @@
+/*
+File:   debug_alignment_styles.cpp
+Author: Will Jenkins
+Purpose: Shared style registry for the debug alignment overlay chrome
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_log.hpp"
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+namespace {
+
+// Button/card fill colors: one style per distinct accent color, created on first use
+struct ColorStyle {
+    uint32_t color;
+    lv_style_t style;
+};
+constexpr int MAX_COLOR_STYLES = 32;
+ColorStyle color_styles[MAX_COLOR_STYLES];
+int color_style_count = 0;
+
+void set_text(lv_style_t* style, uint32_t color, const lv_font_t* font) {
+    lv_style_set_text_color(style, lv_color_hex(color));
+    lv_style_set_text_font(style, font);
+}
+
+}  // namespace
+
+// Every panel look is defined once here and attached with lv_obj_add_style, so a
+// button references shared styles instead of carrying its own local style list.
+lv_style_t DebugAlignmentEnhanced::panel_styles[(int)PanelStyle::COUNT];
+bool DebugAlignmentEnhanced::panel_styles_ready = false;
+DebugAlignmentEnhanced::RenderProfile DebugAlignmentEnhanced::render_profile =
+    DEBUG_ALIGNMENT_LOW_OVERHEAD ? RenderProfile::LOW_OVERHEAD : RenderProfile::RICH;
+
+lv_style_t& DebugAlignmentEnhanced::style_of(PanelStyle style) {
+    return panel_styles[(int)style];
+}
+
+void DebugAlignmentEnhanced::init_styles() {
+    if (panel_styles_ready) return;
+    for (auto& style : panel_styles) {
+        lv_style_init(&style);
+    }
+    define_panel_styles();
+    panel_styles_ready = true;
+}
+
+void DebugAlignmentEnhanced::define_panel_styles() {
+    lv_style_t* s;
+
+    // Toggle button: dark blue-gray to bright blue
+    s = &style_of(PanelStyle::TOGGLE_BUTTON);
+    lv_style_set_bg_color(s, lv_color_hex(0x2C3E50));
+    lv_style_set_bg_grad_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_bg_grad_dir(s, LV_GRAD_DIR_VER);
+    lv_style_set_radius(s, 20);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 8);
+    lv_style_set_shadow_opa(s, LV_OPA_40);
+
+    // Main panel: semi-transparent glassmorphism
+    s = &style_of(PanelStyle::PANEL);
+    lv_style_set_bg_color(s, lv_color_hex(0x1E1E1E));
+    lv_style_set_bg_opa(s, LV_OPA_40);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 3);
+    lv_style_set_radius(s, 25);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 15);
+    lv_style_set_shadow_opa(s, LV_OPA_60);
+    lv_style_set_pad_all(s, 20);
+
+    s = &style_of(PanelStyle::LIST_AREA);
+    lv_style_set_bg_color(s, lv_color_hex(0x2C3E50));
+    lv_style_set_bg_opa(s, LV_OPA_50);
+    lv_style_set_radius(s, 15);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_pad_all(s, 15);
+
+    s = &style_of(PanelStyle::CONTENT_AREA);
+    lv_style_set_bg_color(s, lv_color_hex(0x34495E));
+    lv_style_set_bg_opa(s, LV_OPA_40);
+    lv_style_set_radius(s, 15);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_pad_all(s, 20);
+
+    // Invisible containers: retained content roots, the chip strip and its spacer
+    s = &style_of(PanelStyle::TRANSPARENT);
+    lv_style_set_bg_opa(s, LV_OPA_TRANSP);
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 0);
+
+    // Wrapping flex grid used by every control group and the spawn menu
+    s = &style_of(PanelStyle::CONTROL_GRID);
+    lv_style_set_bg_opa(s, LV_OPA_TRANSP);
+    lv_style_set_border_opa(s, LV_OPA_TRANSP);
+    lv_style_set_pad_all(s, 10);
+    lv_style_set_pad_row(s, 10);
+    lv_style_set_pad_column(s, 10);
+    lv_style_set_layout(s, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(s, LV_FLEX_FLOW_ROW_WRAP);
+    lv_style_set_flex_main_place(s, LV_FLEX_ALIGN_SPACE_EVENLY);
+    lv_style_set_flex_cross_place(s, LV_FLEX_ALIGN_START);
+    lv_style_set_flex_track_place(s, LV_FLEX_ALIGN_START);
+
+    // Object controls header
+    s = &style_of(PanelStyle::HEADER);
+    lv_style_set_bg_color(s, lv_color_hex(0x2C3E50));
+    lv_style_set_bg_opa(s, LV_OPA_90);
+    lv_style_set_radius(s, 12);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_pad_all(s, 15);
+
+    // Header action row
+    s = &style_of(PanelStyle::ACTION_ROW);
+    lv_style_set_bg_opa(s, LV_OPA_TRANSP);
+    lv_style_set_border_opa(s, LV_OPA_TRANSP);
+    lv_style_set_pad_all(s, 5);
+    lv_style_set_pad_column(s, 10);
+    lv_style_set_layout(s, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(s, LV_FLEX_FLOW_ROW);
+    lv_style_set_flex_main_place(s, LV_FLEX_ALIGN_END);
+    lv_style_set_flex_cross_place(s, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(s, LV_FLEX_ALIGN_CENTER);
+
+    s = &style_of(PanelStyle::TAB_VIEW);
+    lv_style_set_bg_color(s, lv_color_hex(0x34495E));
+    lv_style_set_radius(s, 12);
+
+    s = &style_of(PanelStyle::TAB_BAR);
+    lv_style_set_bg_color(s, lv_color_hex(0x2C3E50));
+    set_text(s, 0xECF0F1, &lv_font_montserrat_16);
+
+    s = &style_of(PanelStyle::TAB_PAGE);
+    lv_style_set_pad_all(s, 20);
+    lv_style_set_bg_color(s, lv_color_hex(0x34495E));
+
+    s = &style_of(PanelStyle::SECTION);
+    lv_style_set_bg_color(s, lv_color_hex(0x2C3E50));
+    lv_style_set_bg_opa(s, LV_OPA_60);
+    lv_style_set_radius(s, 10);
+    lv_style_set_border_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_border_width(s, 1);
+    lv_style_set_border_opa(s, LV_OPA_50);
+    lv_style_set_pad_all(s, 15);
+
+    // Modern buttons; the fill comes from the per-color style
+    s = &style_of(PanelStyle::BUTTON);
+    lv_style_set_bg_grad_dir(s, LV_GRAD_DIR_VER);
+    lv_style_set_radius(s, 8);
+    lv_style_set_border_color(s, lv_color_hex(0xECF0F1));
+    lv_style_set_border_width(s, 1);
+    lv_style_set_border_opa(s, LV_OPA_30);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 3);
+    lv_style_set_shadow_opa(s, LV_OPA_30);
+
+    // Hover effect shared by buttons, cards and chips
+    s = &style_of(PanelStyle::PRESSED);
+    lv_style_set_transform_zoom(s, 105);
+
+    // Spawn menu cards; the fill comes from the per-color style
+    s = &style_of(PanelStyle::CARD);
+    lv_style_set_bg_grad_dir(s, LV_GRAD_DIR_VER);
+    lv_style_set_radius(s, 15);
+    lv_style_set_border_color(s, lv_color_hex(0xECF0F1));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_border_opa(s, LV_OPA_30);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 10);
+    lv_style_set_shadow_opa(s, LV_OPA_30);
+    lv_style_set_pad_all(s, 15);
+
+    s = &style_of(PanelStyle::CARD_PRESSED);
+    lv_style_set_transform_zoom(s, 105);
+    lv_style_set_shadow_width(s, 15);
+
+    // "New Widget" button
+    s = &style_of(PanelStyle::NEW_BUTTON);
+    lv_style_set_bg_color(s, lv_color_hex(0x27AE60));
+    lv_style_set_bg_grad_color(s, lv_color_hex(0x2ECC71));
+    lv_style_set_bg_grad_dir(s, LV_GRAD_DIR_VER);
+    lv_style_set_radius(s, 12);
+    lv_style_set_border_color(s, lv_color_hex(0xECF0F1));
+    lv_style_set_border_width(s, 2);
+    lv_style_set_border_opa(s, LV_OPA_30);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 5);
+    lv_style_set_shadow_opa(s, LV_OPA_30);
+
+    // Object list chips
+    s = &style_of(PanelStyle::CHIP);
+    lv_style_set_bg_grad_dir(s, LV_GRAD_DIR_VER);
+    lv_style_set_radius(s, 15);
+    lv_style_set_border_opa(s, LV_OPA_50);
+    lv_style_set_shadow_color(s, lv_color_hex(0x000000));
+    lv_style_set_shadow_width(s, 3);
+    lv_style_set_shadow_opa(s, LV_OPA_20);
+
+    s = &style_of(PanelStyle::CHIP_ACTIVE);
+    lv_style_set_bg_color(s, lv_color_hex(0x3498DB));
+    lv_style_set_bg_grad_color(s, lv_color_hex(0x2980B9));
+    lv_style_set_border_color(s, lv_color_hex(0xECF0F1));
+    lv_style_set_border_width(s, 2);
+
+    s = &style_of(PanelStyle::CHIP_INACTIVE);
+    lv_style_set_bg_color(s, lv_color_hex(0x95A5A6));
+    lv_style_set_bg_grad_color(s, lv_color_hex(0x7F8C8D));
+    lv_style_set_border_color(s, lv_color_hex(0xBDC3C7));
+    lv_style_set_border_width(s, 1);
+
+    // Legacy create_button() look
+    s = &style_of(PanelStyle::PLAIN_BUTTON);
+    lv_style_set_bg_color(s, lv_color_hex(0x333333));
+
+    // Text
+    set_text(&style_of(PanelStyle::TEXT_BUTTON), 0xFFFFFF, &lv_font_montserrat_14);
+    set_text(&style_of(PanelStyle::TEXT_BUTTON_LARGE), 0xFFFFFF, &lv_font_montserrat_20);
+    set_text(&style_of(PanelStyle::TEXT_TITLE), 0xECF0F1, &lv_font_montserrat_32);
+    set_text(&style_of(PanelStyle::TEXT_HEADING), 0xECF0F1, &lv_font_montserrat_24);
+    set_text(&style_of(PanelStyle::TEXT_SECTION), 0xECF0F1, &lv_font_montserrat_20);
+    set_text(&style_of(PanelStyle::TEXT_SUBTITLE), 0xBDC3C7, &lv_font_montserrat_20);
+    set_text(&style_of(PanelStyle::TEXT_SMALL), 0xBDC3C7, &lv_font_montserrat_14);
+    set_text(&style_of(PanelStyle::TEXT_VALUE), 0xECF0F1, &lv_font_montserrat_16);
+    set_text(&style_of(PanelStyle::TEXT_MUTED), 0x95A5A6, &lv_font_montserrat_14);
+    set_text(&style_of(PanelStyle::TEXT_CARD_DESC), 0xECF0F1, &lv_font_montserrat_14);
+    lv_style_set_text_align(&style_of(PanelStyle::TEXT_CARD_DESC), LV_TEXT_ALIGN_CENTER);
+    lv_style_set_text_align(&style_of(PanelStyle::TEXT_SMALL), LV_TEXT_ALIGN_CENTER);
+
+    if (render_profile != RenderProfile::LOW_OVERHEAD) return;
+
+    // Low-overhead profile: every layer that blends over the live screen becomes opaque,
+    // and shadows, gradients and the pressed zoom (a transformed layer) are dropped
+    const PanelStyle translucent[] = {
+        PanelStyle::PANEL, PanelStyle::LIST_AREA, PanelStyle::CONTENT_AREA,
+        PanelStyle::HEADER, PanelStyle::SECTION,
+    };
+    for (PanelStyle id : translucent) {
+        lv_style_set_bg_opa(&style_of(id), LV_OPA_COVER);
+    }
+    const PanelStyle decorated[] = {
+        PanelStyle::TOGGLE_BUTTON, PanelStyle::PANEL, PanelStyle::BUTTON, PanelStyle::CARD,
+        PanelStyle::CARD_PRESSED, PanelStyle::NEW_BUTTON, PanelStyle::CHIP,
+    };
+    for (PanelStyle id : decorated) {
+        lv_style_set_shadow_width(&style_of(id), 0);
+        lv_style_set_bg_grad_dir(&style_of(id), LV_GRAD_DIR_NONE);
+    }
+    lv_style_set_transform_zoom(&style_of(PanelStyle::PRESSED), LV_SCALE_NONE);
+    lv_style_set_transform_zoom(&style_of(PanelStyle::CARD_PRESSED), LV_SCALE_NONE);
+}
+
+void DebugAlignmentEnhanced::set_render_profile(RenderProfile profile) {
+    if (profile == render_profile) return;
+    render_profile = profile;
+    if (!panel_styles_ready) return;  // Picked up by the next init()
+
+    // Objects keep pointing at the same lv_style_t, so refilling them restyles everything
+    for (auto& style : panel_styles) {
+        lv_style_reset(&style);
+        lv_style_init(&style);
+    }
+    define_panel_styles();
+    lv_obj_report_style_change(nullptr);
+    DA_LOGI("Render profile: %s", profile == RenderProfile::LOW_OVERHEAD ? "low overhead" : "rich");
+}
+
+void DebugAlignmentEnhanced::reset_styles() {
+    if (!panel_styles_ready) return;
+    for (auto& style : panel_styles) {
+        lv_style_reset(&style);
+    }
+    for (int i = 0; i < color_style_count; i++) {
+        lv_style_reset(&color_styles[i].style);
+    }
+    color_style_count = 0;
+    panel_styles_ready = false;
+}
+
+void DebugAlignmentEnhanced::apply_style(lv_obj_t* obj, PanelStyle style, lv_style_selector_t selector) {
+    lv_obj_add_style(obj, &style_of(style), selector);
+}
+
+void DebugAlignmentEnhanced::remove_style(lv_obj_t* obj, PanelStyle style, lv_style_selector_t selector) {
+    lv_obj_remove_style(obj, &style_of(style), selector);
+}
+
+// Accent fill (color on top, darkened color at the bottom) shared by buttons and cards
+void DebugAlignmentEnhanced::apply_color_style(lv_obj_t* obj, uint32_t color) {
+    for (int i = 0; i < color_style_count; i++) {
+        if (color_styles[i].color == color) {
+            lv_obj_add_style(obj, &color_styles[i].style, LV_PART_MAIN);
+            return;
+        }
+    }
+    if (color_style_count == MAX_COLOR_STYLES) {
+        // Registry full: fall back to local properties rather than failing
+        lv_obj_set_style_bg_color(obj, lv_color_hex(color), LV_PART_MAIN);
+        lv_obj_set_style_bg_grad_color(obj, lv_color_hex(color & 0x7F7F7F), LV_PART_MAIN);
+        return;
+    }
+    ColorStyle& entry = color_styles[color_style_count++];
+    entry.color = color;
+    lv_style_init(&entry.style);
+    lv_style_set_bg_color(&entry.style, lv_color_hex(color));
+    lv_style_set_bg_grad_color(&entry.style, lv_color_hex(color & 0x7F7F7F));
+    lv_obj_add_style(obj, &entry.style, LV_PART_MAIN);
+}
+
+lv_obj_t* DebugAlignmentEnhanced::create_control_grid(lv_obj_t* parent) {
+    lv_obj_t* grid = lv_obj_create(parent);
+    lv_obj_set_size(grid, LV_PCT(100), LV_SIZE_CONTENT);
+    apply_style(grid, PanelStyle::CONTROL_GRID);
+    return grid;
+}
+
+lv_obj_t* DebugAlignmentEnhanced::create_styled_label(lv_obj_t* parent, const char* text, PanelStyle style) {
+    lv_obj_t* label = lv_label_create(parent);
+    lv_label_set_text(label, text);
+    apply_style(label, style);
+    return label;
+}
+
+#endif
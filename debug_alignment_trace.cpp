@@ -0,0 +1,116 @@
+/*
+File:   debug_alignment_trace.cpp
+Author: Will Jenkins
+Purpose: Event handler and refresh timings kept in a ring and written as Chrome trace JSON
+*/
+
+#include "debug_alignment_trace.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr int HANDLER_TID = 1;
+constexpr int REFRESH_TID = 2;
+
+}  // namespace
+
+EventTrace::EventTrace() { names_.emplace_back("handler"); }
+
+uint16_t EventTrace::intern(const void* handler, const char* name) {
+    auto found = ids_.find(handler);
+    if (found != ids_.end()) return found->second;
+    if (names_.size() > UINT16_MAX) return 0;
+    while (*name == ' ') name++;
+    uint16_t id = (uint16_t)names_.size();
+    names_.emplace_back(*name ? name : "handler");
+    ids_.emplace(handler, id);
+    return id;
+}
+
+uint16_t EventTrace::id_of(const void* handler) const {
+    auto found = ids_.find(handler);
+    return found != ids_.end() ? found->second : 0;
+}
+
+void EventTrace::handler(uint16_t name, uint32_t object, uint64_t begin_us, uint64_t end_us) {
+    Record record;
+    record.begin_us = begin_us;
+    record.dur_us = (uint32_t)(end_us - begin_us);
+    record.object = object;
+    record.name = name;
+    record.kind = HANDLER;
+    records_.push(record);
+    refresh_pending_ = true;
+}
+
+void EventTrace::refresh_begin(uint64_t now_us) {
+    refreshing_ = refresh_pending_;
+    refresh_pending_ = false;
+    refresh_begin_us_ = now_us;
+}
+
+void EventTrace::refresh_end(uint64_t now_us) {
+    if (!refreshing_) return;
+    refreshing_ = false;
+    Record record;
+    record.begin_us = refresh_begin_us_;
+    record.dur_us = (uint32_t)(now_us - refresh_begin_us_);
+    record.kind = REFRESH;
+    records_.push(record);
+}
+
+void EventTrace::clear() {
+    records_.clear();
+    refresh_pending_ = false;
+    refreshing_ = false;
+}
+
+// Records are in the order they finished, so the refresh showing a handler's result is
+// the first refresh after it. Timestamps are made relative to the oldest record.
+bool EventTrace::write_json(ExportStream& out) const {
+    std::vector<Record> records;
+    records.reserve(records_.size());
+    records_.for_each([&](const Record& record) { records.push_back(record); });
+    uint64_t base = UINT64_MAX;
+    for (const Record& record : records) base = std::min(base, record.begin_us);
+
+    std::vector<int> next_refresh(records.size(), -1);
+    int next = -1;
+    for (int i = (int)records.size() - 1; i >= 0; i--) {
+        next_refresh[i] = next;
+        if (records[i].kind == REFRESH) next = i;
+    }
+
+    out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Event handlers\"}},\n",
+              HANDLER_TID);
+    out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"LVGL refresh\"}}", REFRESH_TID);
+    for (size_t i = 0; i < records.size(); i++) {
+        const Record& record = records[i];
+        unsigned long long ts = (unsigned long long)(record.begin_us - base);
+        if (record.kind == REFRESH) {
+            out.print(",\n{\"name\":\"refresh\",\"cat\":\"refresh\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":%d}",
+                      ts, (unsigned)record.dur_us, REFRESH_TID);
+            continue;
+        }
+        out.print(",\n{\"name\":");
+        out.write_quoted(record.name < names_.size() ? names_[record.name].c_str() : "handler");
+        out.print(",\"cat\":\"handler\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":%d,\"args\":{\"object\":%u",
+                  ts, (unsigned)record.dur_us, HANDLER_TID, (unsigned)record.object);
+        int shown = next_refresh[i];
+        if (shown < 0) {
+            out.print("}}");
+            continue;
+        }
+        const Record& refresh = records[shown];
+        unsigned long long to_pixel = (unsigned long long)(refresh.begin_us + refresh.dur_us - record.begin_us);
+        out.print(",\"to_pixel_us\":%llu}}", to_pixel);
+        // Arrow from the handler to the refresh that drew its result
+        out.print(",\n{\"name\":\"to pixel\",\"cat\":\"latency\",\"ph\":\"s\",\"id\":%u,\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+                  (unsigned)i, ts, HANDLER_TID);
+        out.print(",\n{\"name\":\"to pixel\",\"cat\":\"latency\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%u,\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+                  (unsigned)i, (unsigned long long)(refresh.begin_us - base), REFRESH_TID);
+    }
+    out.print("\n]}\n");
+    return out.ok();
+}
@@ -0,0 +1,64 @@
+/*
+File:   debug_alignment_trace.hpp
+Author: Will Jenkins
+Purpose: Event handler and refresh timings kept in a ring and written as Chrome trace JSON
+*/
+
+#pragma once
+
+#include "debug_alignment_export.hpp"
+#include "debug_alignment_ring.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Records kept; the oldest are overwritten. Must be a power of two.
+#ifndef DEBUG_ALIGNMENT_TRACE_EVENTS
+#define DEBUG_ALIGNMENT_TRACE_EVENTS 512
+#endif
+
+// Handler calls and the display refresh that follows each burst of them. Recording is
+// a timestamp pair and one ring push, with no allocation; names are registered once per
+// handler when its button is created. write_json() produces a file chrome://tracing and
+// Perfetto open: handlers and refreshes on two tracks, with an arrow from each handler to
+// the refresh that put its result on screen and the tap-to-pixel time in its args.
+class EventTrace {
+public:
+    enum Kind : uint8_t { HANDLER, REFRESH };
+    struct Record {
+        uint64_t begin_us = 0;
+        uint32_t dur_us = 0;
+        uint32_t object = 0;  // Serial of the active object after a handler, 0 if none
+        uint16_t name = 0;    // Handler name id
+        uint8_t kind = HANDLER;
+    };
+
+    EventTrace();
+
+    // Name id for a handler, registered with `name` (leading spaces dropped) the first
+    // time the handler is seen; later names for the same handler are ignored
+    uint16_t intern(const void* handler, const char* name);
+    // 0 ("handler") for one that was never registered
+    uint16_t id_of(const void* handler) const;
+
+    void handler(uint16_t name, uint32_t object, uint64_t begin_us, uint64_t end_us);
+    // A refresh is only recorded when a handler ran since the last one
+    void refresh_begin(uint64_t now_us);
+    void refresh_end(uint64_t now_us);
+
+    size_t buffered() const { return records_.size(); }
+    uint64_t recorded() const { return records_.pushed(); }
+    // Drops the records; names stay registered
+    void clear();
+
+    bool write_json(ExportStream& out) const;
+
+private:
+    LatestRing<Record, DEBUG_ALIGNMENT_TRACE_EVENTS> records_;
+    std::unordered_map<const void*, uint16_t> ids_;
+    std::vector<std::string> names_;
+    uint64_t refresh_begin_us_ = 0;
+    bool refresh_pending_ = false;  // A handler ran since the last recorded refresh
+    bool refreshing_ = false;
+};
@@ -0,0 +1,106 @@
+/*
+File:   debug_alignment_trace_hooks.cpp
+Author: Will Jenkins
+Purpose: Traced event callbacks, display refresh hooks and the Save button for the event trace
+*/
+
+#include "debug_alignment_enhanced.hpp"
+#include "debug_alignment_clock.hpp"
+#include "debug_alignment_log.hpp"
+#include <cstdio>
+
+#if ENABLE_DEBUG_ALIGNMENT
+
+// Where the Save button writes the event trace
+#ifndef DEBUG_ALIGNMENT_TRACE_PATH
+#define DEBUG_ALIGNMENT_TRACE_PATH "debug_alignment_trace.json"
+#endif
+
+EventTrace DebugAlignmentEnhanced::event_trace;
+lv_display_t* DebugAlignmentEnhanced::trace_display = nullptr;
+lv_obj_t* DebugAlignmentEnhanced::trace_label = nullptr;
+
+namespace {
+
+// Trace JSON is gathered here and written in large chunks
+char trace_buffer[DEBUG_ALIGNMENT_EXPORT_BUFFER];
+
+}  // namespace
+
+// Input callbacks that are not journaled; the name is what the trace shows
+void DebugAlignmentEnhanced::add_traced_event_cb(lv_obj_t* obj, lv_event_cb_t handler, lv_event_code_t code,
+                                                 const char* name) {
+    event_trace.intern(reinterpret_cast<const void*>(handler), name);
+    lv_obj_add_event_cb(obj, traced_event, code, reinterpret_cast<void*>(handler));
+}
+
+void DebugAlignmentEnhanced::traced_event(lv_event_t* e) {
+    lv_event_cb_t handler = reinterpret_cast<lv_event_cb_t>(lv_event_get_user_data(e));
+    uint64_t begin = DEBUG_ALIGNMENT_TIME_US();
+    handler(e);
+    trace_handler(handler, begin);
+}
+
+// Pushed once the handler has returned; the record carries whichever object is active then
+void DebugAlignmentEnhanced::trace_handler(lv_event_cb_t handler, uint64_t begin_us) {
+    const SpawnedObject* active = active_object();
+    event_trace.handler(event_trace.id_of(reinterpret_cast<const void*>(handler)), active ? active->serial : 0,
+                        begin_us, DEBUG_ALIGNMENT_TIME_US());
+}
+
+// The whole refresh, layout included, since that is where deferred handler work lands
+void DebugAlignmentEnhanced::start_trace_hooks() {
+    if (trace_display || !parent_screen) return;
+    trace_display = lv_obj_get_display(parent_screen);
+    if (!trace_display) return;
+    lv_display_add_event_cb(trace_display, trace_display_event, LV_EVENT_REFR_START, nullptr);
+    lv_display_add_event_cb(trace_display, trace_display_event, LV_EVENT_REFR_READY, nullptr);
+}
+
+void DebugAlignmentEnhanced::stop_trace_hooks() {
+    if (!trace_display) return;
+    lv_display_remove_event_cb_with_user_data(trace_display, trace_display_event, nullptr);
+    trace_display = nullptr;
+}
+
+void DebugAlignmentEnhanced::trace_display_event(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        event_trace.refresh_begin(DEBUG_ALIGNMENT_TIME_US());
+    } else {
+        event_trace.refresh_end(DEBUG_ALIGNMENT_TIME_US());
+    }
+}
+
+bool DebugAlignmentEnhanced::export_trace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        DA_LOGE("Could not open %s for the event trace", path);
+        return false;
+    }
+    bool ok;
+    {
+        ExportStream out(file, trace_buffer, sizeof(trace_buffer));
+        ok = event_trace.write_json(out) && out.flush();
+        DA_LOGI("Wrote %u trace records (%u bytes) to %s", (unsigned)event_trace.buffered(),
+                (unsigned)out.bytes_written(), path);
+    }
+    if (fclose(file) != 0) ok = false;
+    if (!ok) DA_LOGE("Event trace to %s failed", path);
+    return ok;
+}
+
+void DebugAlignmentEnhanced::trace_save_event(lv_event_t*) {
+    export_trace(DEBUG_ALIGNMENT_TRACE_PATH);
+    refresh_trace_report();
+}
+
+void DebugAlignmentEnhanced::refresh_trace_report() {
+    if (!trace_label) return;
+    char text[160];
+    snprintf(text, sizeof(text), "%u records buffered (%llu recorded, newest %u kept)\nSave writes %s",
+             (unsigned)event_trace.buffered(), (unsigned long long)event_trace.recorded(),
+             (unsigned)DEBUG_ALIGNMENT_TRACE_EVENTS, DEBUG_ALIGNMENT_TRACE_PATH);
+    lv_label_set_text(trace_label, text);
+}
+
+#endif  // ENABLE_DEBUG_ALIGNMENT